@@ -0,0 +1,48 @@
+//===-- checks/CStrCallCheck.h - Redundant c_str call removal ---*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+//  Matches calls of c_str() on strings whose result is passed where the
+//  string itself would do, and replaces them with the string.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_TOOLS_EXTRA_CHECKS_CSTRCALLCHECK_H
+#define LLVM_TOOLS_EXTRA_CHECKS_CSTRCALLCHECK_H
+
+#include "Check.h"
+
+namespace clang {
+namespace checks {
+
+class FixCStrCall : public ast_matchers::MatchFinder::MatchCallback {
+ public:
+  FixCStrCall(tooling::Replacements *Replace)
+      : Replace(Replace) {}
+
+  virtual void run(const ast_matchers::MatchFinder::MatchResult &Result);
+
+ private:
+  tooling::Replacements *Replace;
+};
+
+/// \brief Every match is a call of c_str(), spelled out.
+extern const char *CStrCallTrigger;
+
+/// \brief Adds the matchers for redundant c_str() calls, which report to
+/// Callback.
+void addCStrCallMatchers(ast_matchers::MatchFinder &Finder,
+                         FixCStrCall &Callback);
+
+/// \brief The same, as a Check.
+Check *createCStrCallCheck();
+
+} // end namespace checks
+} // end namespace clang
+
+#endif // LLVM_TOOLS_EXTRA_CHECKS_CSTRCALLCHECK_H
@@ -0,0 +1,61 @@
+//===-- checks/Check.cpp - Checks sharing one parse -----------------------===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "Check.h"
+#include "CStrCallCheck.h"
+#include "StringEmptyCheck.h"
+
+namespace clang {
+namespace checks {
+
+Check::~Check() {}
+
+static std::vector<CheckInfo> &registry() {
+  static std::vector<CheckInfo> Checks;
+  if (Checks.empty()) {
+    CheckInfo CStrCalls = {
+      "remove-cstr-calls",
+      "Remove redundant calls of c_str() on strings",
+      &createCStrCallCheck
+    };
+    Checks.push_back(CStrCalls);
+    CheckInfo StringEmpty = {
+      "string-empty",
+      "Replace comparisons of a string's size() with 0 by empty()",
+      &createStringEmptyCheck
+    };
+    Checks.push_back(StringEmpty);
+  }
+  return Checks;
+}
+
+bool CheckRegistry::add(const char *Name, const char *Description,
+                        CheckFactory Create) {
+  if (find(Name))
+    return false;
+  CheckInfo Info = { Name, Description, Create };
+  registry().push_back(Info);
+  return true;
+}
+
+const std::vector<CheckInfo> &CheckRegistry::checks() {
+  return registry();
+}
+
+const CheckInfo *CheckRegistry::find(llvm::StringRef Name) {
+  const std::vector<CheckInfo> &Checks = registry();
+  for (unsigned I = 0, E = Checks.size(); I != E; ++I) {
+    if (Name == Checks[I].Name)
+      return &Checks[I];
+  }
+  return NULL;
+}
+
+} // end namespace checks
+} // end namespace clang
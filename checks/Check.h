@@ -0,0 +1,76 @@
+//===-- checks/Check.h - Checks sharing one parse ---------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+//  A check is a set of AST matchers and the callbacks that turn their
+//  matches into replacements.  Checks add their matchers to one MatchFinder,
+//  so that any number of them are run with a single parse and traversal of
+//  each translation unit.  Each keeps its replacements apart from the
+//  others'.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_TOOLS_EXTRA_CHECKS_CHECK_H
+#define LLVM_TOOLS_EXTRA_CHECKS_CHECK_H
+
+#include "clang/ASTMatchers/ASTMatchFinder.h"
+#include "clang/Tooling/Refactoring.h"
+#include "llvm/ADT/StringRef.h"
+
+#include <vector>
+
+namespace clang {
+namespace checks {
+
+/// \brief A set of matchers whose callbacks record replacements.
+class Check {
+ public:
+  virtual ~Check();
+
+  /// \brief Adds the check's matchers to Finder.  Their callbacks record
+  /// edits in Replace.  Finder and Replace outlive the check.
+  virtual void registerMatchers(ast_matchers::MatchFinder &Finder,
+                                tooling::Replacements *Replace) = 0;
+
+  /// \brief Adds identifiers to Identifiers, one of which must be spelled
+  /// out in a file for the check to match there.  Returns false if the
+  /// check has no such identifiers, and no file can be skipped for it.
+  virtual bool getTriggers(std::vector<std::string> &Identifiers) const {
+    return false;
+  }
+};
+
+typedef Check *(*CheckFactory)();
+
+struct CheckInfo {
+  const char *Name;
+  const char *Description;
+  CheckFactory Create;
+};
+
+/// \brief The checks a driver can choose from.  The checks in this
+/// library are always there, listed in registry() in Check.cpp.  A tool
+/// can add its own before looking them up, but only that tool sees them;
+/// for run-checks to run a check, it must be in this library.
+class CheckRegistry {
+ public:
+  /// \brief Adds a check.  Returns false if the name is already taken.
+  static bool add(const char *Name, const char *Description,
+                  CheckFactory Create);
+
+  /// \brief All registered checks, in the order they were added.
+  static const std::vector<CheckInfo> &checks();
+
+  /// \brief Returns the check called Name, or NULL.
+  static const CheckInfo *find(llvm::StringRef Name);
+};
+
+} // end namespace checks
+} // end namespace clang
+
+#endif // LLVM_TOOLS_EXTRA_CHECKS_CHECK_H
@@ -0,0 +1,141 @@
+//===-- checks/MainFileMatch.cpp - Match in our own code only -------------===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "MainFileMatch.h"
+#include "clang/AST/ASTConsumer.h"
+#include "clang/AST/ASTContext.h"
+#include "clang/AST/Decl.h"
+#include "clang/AST/RecursiveASTVisitor.h"
+#include "clang/Basic/FileManager.h"
+#include "clang/Basic/SourceManager.h"
+#include "clang/Frontend/FrontendAction.h"
+#include "llvm/ADT/StringRef.h"
+
+#include <vector>
+
+namespace clang {
+namespace checks {
+
+namespace {
+// Runs Finder on every declaration and statement under one top-level
+// declaration, visiting what MatchFinder's own traversal would.
+class DeclMatcher : public RecursiveASTVisitor<DeclMatcher> {
+ public:
+  DeclMatcher(ast_matchers::MatchFinder &Finder, ASTContext &Context)
+      : Finder(Finder), Context(Context) {}
+
+  bool shouldVisitTemplateInstantiations() const { return true; }
+  bool shouldVisitImplicitCode() const { return true; }
+
+  bool VisitDecl(Decl *D) {
+    Finder.match(*D, Context);
+    return true;
+  }
+  bool VisitStmt(Stmt *S) {
+    Finder.match(*S, Context);
+    return true;
+  }
+
+ private:
+  ast_matchers::MatchFinder &Finder;
+  ASTContext &Context;
+};
+
+// Matches the top-level declarations that are allowed, leaving the
+// translation unit as it was parsed.
+class AllowedDeclsConsumer : public ASTConsumer {
+ public:
+  AllowedDeclsConsumer(ast_matchers::MatchFinder &Finder,
+                       const std::vector<std::string> &AllowedDirs)
+      : Finder(Finder), AllowedDirs(AllowedDirs) {}
+
+  virtual void HandleTranslationUnit(ASTContext &Context) {
+    TranslationUnitDecl *TU = Context.getTranslationUnitDecl();
+    const SourceManager &Sources = Context.getSourceManager();
+    DeclMatcher Matcher(Finder, Context);
+    for (DeclContext::decl_iterator I = TU->decls_begin(),
+                                    E = TU->decls_end();
+         I != E; ++I) {
+      if (isAllowed(Sources, (*I)->getLocation()))
+        Matcher.TraverseDecl(*I);
+    }
+  }
+
+ private:
+  bool isAllowed(const SourceManager &Sources, SourceLocation Loc) const {
+    // Builtin and implicit declarations have no location.
+    if (Loc.isInvalid())
+      return false;
+    Loc = Sources.getExpansionLoc(Loc);
+    if (Sources.isFromMainFile(Loc))
+      return true;
+    if (AllowedDirs.empty())
+      return false;
+    const FileEntry *Entry =
+        Sources.getFileEntryForID(Sources.getFileID(Loc));
+    if (!Entry)
+      return false;
+    std::string Path = tooling::getAbsolutePath(Entry->getName());
+    for (unsigned I = 0, E = AllowedDirs.size(); I != E; ++I) {
+      const std::string &Dir = AllowedDirs[I];
+      if (Path.size() > Dir.size() && Path[Dir.size()] == '/' &&
+          Path.compare(0, Dir.size(), Dir) == 0)
+        return true;
+    }
+    return false;
+  }
+
+  ast_matchers::MatchFinder &Finder;
+  const std::vector<std::string> &AllowedDirs;
+};
+
+class MainFileMatchAction : public ASTFrontendAction {
+ public:
+  MainFileMatchAction(ast_matchers::MatchFinder *Finder,
+                      const std::vector<std::string> &AllowedDirs)
+      : Finder(Finder), AllowedDirs(AllowedDirs) {}
+
+ protected:
+  virtual ASTConsumer *CreateASTConsumer(CompilerInstance &CI,
+                                         llvm::StringRef InFile) {
+    return new AllowedDeclsConsumer(*Finder, AllowedDirs);
+  }
+
+ private:
+  ast_matchers::MatchFinder *Finder;
+  const std::vector<std::string> &AllowedDirs;
+};
+
+class MainFileMatchActionFactory : public tooling::FrontendActionFactory {
+ public:
+  MainFileMatchActionFactory(ast_matchers::MatchFinder *Finder,
+                             llvm::ArrayRef<std::string> AllowedDirs)
+      : Finder(Finder) {
+    for (unsigned I = 0, E = AllowedDirs.size(); I != E; ++I)
+      this->AllowedDirs.push_back(llvm::StringRef(AllowedDirs[I]).rtrim('/'));
+  }
+
+  virtual FrontendAction *create() {
+    return new MainFileMatchAction(Finder, AllowedDirs);
+  }
+
+ private:
+  ast_matchers::MatchFinder *Finder;
+  std::vector<std::string> AllowedDirs;
+};
+} // end namespace
+
+tooling::FrontendActionFactory *newMainFileMatchActionFactory(
+    ast_matchers::MatchFinder *Finder,
+    llvm::ArrayRef<std::string> AllowedDirs) {
+  return new MainFileMatchActionFactory(Finder, AllowedDirs);
+}
+
+} // end namespace checks
+} // end namespace clang
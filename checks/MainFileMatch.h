@@ -0,0 +1,42 @@
+//===-- checks/MainFileMatch.h - Match in our own code only -----*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+//  MatchFinder visits every declaration in a translation unit, most of
+//  which come from system and third-party headers that a tool never edits.
+//  The actions made here run MatchFinder only over the top-level
+//  declarations in the main file and a list of allowed directories; the
+//  translation unit itself is left as parsed.  Matchers can still look
+//  through the nodes they do visit into the skipped declarations, e.g. with
+//  hasDeclaration().
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_TOOLS_EXTRA_CHECKS_MAINFILEMATCH_H
+#define LLVM_TOOLS_EXTRA_CHECKS_MAINFILEMATCH_H
+
+#include "clang/ASTMatchers/ASTMatchFinder.h"
+#include "clang/Tooling/Tooling.h"
+#include "llvm/ADT/ArrayRef.h"
+
+#include <string>
+
+namespace clang {
+namespace checks {
+
+/// \brief Returns a factory for actions that run Finder over the top-level
+/// declarations in the main file and in files under AllowedDirs, which
+/// must be absolute.  The caller owns the factory.
+tooling::FrontendActionFactory *newMainFileMatchActionFactory(
+    ast_matchers::MatchFinder *Finder,
+    llvm::ArrayRef<std::string> AllowedDirs);
+
+} // end namespace checks
+} // end namespace clang
+
+#endif // LLVM_TOOLS_EXTRA_CHECKS_MAINFILEMATCH_H
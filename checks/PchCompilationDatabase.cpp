@@ -0,0 +1,265 @@
+//===-- checks/PchCompilationDatabase.cpp - Shared prefix PCHs ------------===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "PchCompilationDatabase.h"
+#include "clang/Basic/FileManager.h"
+#include "clang/Basic/LangOptions.h"
+#include "clang/Frontend/FrontendActions.h"
+#include "clang/Lex/Lexer.h"
+#include "clang/Tooling/Tooling.h"
+#include "llvm/ADT/OwningPtr.h"
+#include "llvm/ADT/SmallString.h"
+#include "llvm/ADT/Twine.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Path.h"
+#include "llvm/Support/raw_ostream.h"
+#include "llvm/Support/system_error.h"
+
+#include <unistd.h>
+
+namespace clang {
+namespace checks {
+
+namespace {
+// Files whose prefixes are precompiled together.
+struct Group {
+  std::string Directory;
+  std::string SourceDir;
+  std::vector<std::string> Flags;
+  std::string Prefix;
+  std::vector<std::string> Files;
+};
+} // end namespace
+
+// Returns true if Arg, given to a command run in Directory, names File.
+static bool namesFile(llvm::StringRef Arg, llvm::StringRef Directory,
+                      llvm::StringRef File) {
+  if (llvm::sys::path::is_absolute(Arg))
+    return Arg == File;
+  if (Arg.startswith("./"))
+    Arg = Arg.substr(2);
+  llvm::SmallString<256> Path(Directory);
+  llvm::sys::path::append(Path, Arg);
+  return Path.str() == File;
+}
+
+// The command line without the source file and the options naming outputs,
+// which differ from file to file but don't change how headers are parsed.
+static std::vector<std::string> compileFlags(
+    const tooling::CompileCommand &Command, llvm::StringRef File) {
+  std::vector<std::string> Flags;
+  const std::vector<std::string> &Args = Command.CommandLine;
+  for (unsigned I = 0, E = Args.size(); I < E; ++I) {
+    llvm::StringRef Arg = Args[I];
+    if (I > 0) {
+      if (Arg == "-c" || Arg == "-MD" || Arg == "-MMD")
+        continue;
+      if (Arg == "-o" || Arg == "-MF" || Arg == "-MT" || Arg == "-MQ") {
+        ++I;
+        continue;
+      }
+      if (Arg.startswith("-o") || namesFile(Arg, Command.Directory, File))
+        continue;
+    }
+    Flags.push_back(Arg);
+  }
+  return Flags;
+}
+
+// The -x language for a header included by File.
+static const char *headerLanguage(llvm::StringRef File) {
+  llvm::StringRef Ext = llvm::sys::path::extension(File);
+  if (Ext == ".c")
+    return "c-header";
+  if (Ext == ".m")
+    return "objective-c-header";
+  if (Ext == ".mm")
+    return "objective-c++-header";
+  return "c++-header";
+}
+
+// The prefix header lives in the PCH directory, but a quoted #include is
+// looked up next to the file that includes it first.  Returns Prefix with
+// each quoted #include of a file next to the source naming it by absolute
+// path, so the header includes what the source would, without a search
+// path that would also apply to every other header.
+static std::string anchorIncludes(llvm::StringRef Prefix,
+                                  llvm::StringRef SourceDir) {
+  std::string Result;
+  while (!Prefix.empty()) {
+    std::pair<llvm::StringRef, llvm::StringRef> Split = Prefix.split('\n');
+    llvm::StringRef Line = Split.first;
+    bool More = Line.size() < Prefix.size();
+    Prefix = Split.second;
+
+    llvm::StringRef Rest = Line.ltrim();
+    if (Rest.startswith("#")) {
+      Rest = Rest.substr(1).ltrim();
+      llvm::StringRef Directive = Rest.startswith("include") ? "include" :
+                                  Rest.startswith("import") ? "import" : "";
+      Rest = Rest.substr(Directive.size());
+      // Not #include_next, and not #include MACRO.
+      if (!Directive.empty() && !Rest.empty() &&
+          (Rest[0] == ' ' || Rest[0] == '\t' || Rest[0] == '"')) {
+        Rest = Rest.ltrim();
+        size_t Close = Rest.startswith("\"") ? Rest.find('"', 1)
+                                              : llvm::StringRef::npos;
+        if (Close != llvm::StringRef::npos) {
+          llvm::StringRef Name = Rest.substr(1, Close - 1);
+          llvm::SmallString<256> Path(SourceDir);
+          llvm::sys::path::append(Path, Name);
+          bool Exists = false;
+          if (!llvm::sys::path::is_absolute(Name) &&
+              !llvm::sys::fs::exists(Path.str(), Exists) && Exists) {
+            Result += Line.substr(0, Rest.data() - Line.data());
+            Result += "\"";
+            Result += Path.str();
+            Result += Rest.substr(Close);
+            if (More)
+              Result += '\n';
+            continue;
+          }
+        }
+      }
+    }
+    Result += Line;
+    if (More)
+      Result += '\n';
+  }
+  return Result;
+}
+
+// Precompiles Header into Pch with G's command, as ClangTool would run it.
+static bool buildPch(const Group &G, const std::string &Header,
+                     const std::string &Pch) {
+  std::vector<std::string> Args = G.Flags;
+  Args.push_back("-x");
+  Args.push_back(headerLanguage(G.Files.front()));
+  Args.push_back(Header);
+  Args.push_back("-o");
+  Args.push_back(Pch);
+
+  llvm::SmallString<256> Cwd;
+  if (llvm::sys::fs::current_path(Cwd))
+    return false;
+  if (chdir(G.Directory.c_str()))
+    return false;
+  FileManager Files((FileSystemOptions()));
+  tooling::ToolInvocation Invocation(Args, new GeneratePCHAction, &Files);
+  bool Ok = Invocation.run();
+  if (chdir(Cwd.c_str()))
+    return false;
+  return Ok;
+}
+
+PchCompilationDatabase::PchCompilationDatabase(
+    const tooling::CompilationDatabase &Base, llvm::StringRef Dir)
+    : Base(Base), Dir(tooling::getAbsolutePath(Dir)), Built(0) {}
+
+void PchCompilationDatabase::build(llvm::ArrayRef<std::string> SourcePaths) {
+  bool Existed;
+  if (llvm::sys::fs::create_directories(Dir, Existed)) {
+    llvm::errs() << "Could not create " << Dir << "\n";
+    return;
+  }
+
+  // Keyed by everything that must match for a PCH to be shared; a map
+  // keeps the numbering of the headers the same from run to run.
+  std::map<std::string, Group> Groups;
+  for (unsigned I = 0, E = SourcePaths.size(); I != E; ++I) {
+    std::string File = tooling::getAbsolutePath(SourcePaths[I]);
+    std::vector<tooling::CompileCommand> Commands =
+        Base.getCompileCommands(File);
+    // A file built more than one way is left alone.
+    if (Commands.size() != 1)
+      continue;
+    llvm::OwningPtr<llvm::MemoryBuffer> Buffer;
+    if (llvm::MemoryBuffer::getFile(File, Buffer))
+      continue;
+    std::pair<unsigned, bool> Preamble =
+        Lexer::ComputePreamble(Buffer.get(), LangOptions());
+    if (Preamble.first == 0)
+      continue;
+
+    Group G;
+    G.Directory = Commands[0].Directory;
+    G.SourceDir = llvm::sys::path::parent_path(File);
+    G.Flags = compileFlags(Commands[0], File);
+    G.Prefix = Buffer->getBuffer().substr(0, Preamble.first);
+
+    std::string Key = G.Directory;
+    Key += '\0';
+    Key += G.SourceDir;
+    for (unsigned J = 0, F = G.Flags.size(); J != F; ++J) {
+      Key += '\0';
+      Key += G.Flags[J];
+    }
+    Key += '\0';
+    Key += G.Prefix;
+
+    std::map<std::string, Group>::iterator Found = Groups.find(Key);
+    if (Found == Groups.end())
+      Found = Groups.insert(std::make_pair(Key, G)).first;
+    Found->second.Files.push_back(File);
+  }
+
+  unsigned N = 0;
+  for (std::map<std::string, Group>::const_iterator I = Groups.begin(),
+                                                    E = Groups.end();
+       I != E; ++I) {
+    const Group &G = I->second;
+    if (G.Files.size() < 2)
+      continue;
+    llvm::SmallString<256> Header(Dir);
+    llvm::sys::path::append(Header, "prefix-" + llvm::Twine(N++) + ".h");
+    std::string Pch = Header.str().str() + ".pch";
+
+    std::string ErrorInfo;
+    llvm::raw_fd_ostream Out(Header.c_str(), ErrorInfo);
+    if (!ErrorInfo.empty())
+      continue;
+    Out << anchorIncludes(G.Prefix, G.SourceDir) << "\n";
+    Out.close();
+
+    if (!buildPch(G, Header.str().str(), Pch)) {
+      llvm::errs() << "Could not precompile the prefix of "
+                   << G.Files.front() << "\n";
+      continue;
+    }
+    ++Built;
+    for (unsigned J = 0, F = G.Files.size(); J != F; ++J)
+      Pchs[G.Files[J]] = Pch;
+  }
+}
+
+std::vector<tooling::CompileCommand>
+PchCompilationDatabase::getCompileCommands(llvm::StringRef FilePath) const {
+  std::vector<tooling::CompileCommand> Commands =
+      Base.getCompileCommands(FilePath);
+  std::map<std::string, std::string>::const_iterator I =
+      Pchs.find(tooling::getAbsolutePath(FilePath));
+  if (I == Pchs.end() || Commands.size() != 1)
+    return Commands;
+
+  std::vector<std::string> &Args = Commands[0].CommandLine;
+  std::vector<std::string> Inject;
+  Inject.push_back("-include-pch");
+  Inject.push_back(I->second);
+  Args.insert(Args.begin() + (Args.empty() ? 0 : 1), Inject.begin(),
+              Inject.end());
+  return Commands;
+}
+
+std::vector<std::string> PchCompilationDatabase::getAllFiles() const {
+  return Base.getAllFiles();
+}
+
+} // end namespace checks
+} // end namespace clang
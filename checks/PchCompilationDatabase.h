@@ -0,0 +1,65 @@
+//===-- checks/PchCompilationDatabase.h - Shared prefix PCHs ----*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+//  Source files compiled with the same command usually begin with the same
+//  #includes, and a tool parses those headers again for every file.  This
+//  database finds files that share a command, a directory and an include
+//  prefix, precompiles the prefix once, and adds -include-pch to their
+//  commands.  The files still include the headers themselves, so this pays
+//  off only when the headers have include guards or #pragma once.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_TOOLS_EXTRA_CHECKS_PCHCOMPILATIONDATABASE_H
+#define LLVM_TOOLS_EXTRA_CHECKS_PCHCOMPILATIONDATABASE_H
+
+#include "clang/Tooling/CompilationDatabase.h"
+#include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/StringRef.h"
+
+#include <map>
+#include <string>
+#include <vector>
+
+namespace clang {
+namespace checks {
+
+class PchCompilationDatabase : public tooling::CompilationDatabase {
+ public:
+  /// \brief Wraps Base.  The prefix headers and their PCHs are written to
+  /// Dir, which is created if needed.
+  PchCompilationDatabase(const tooling::CompilationDatabase &Base,
+                         llvm::StringRef Dir);
+
+  /// \brief Builds a PCH for each group of two or more of SourcePaths that
+  /// share a prefix.  A group whose PCH doesn't build goes without.
+  void build(llvm::ArrayRef<std::string> SourcePaths);
+
+  /// \brief Base's commands for FilePath, using its group's PCH if any.
+  virtual std::vector<tooling::CompileCommand> getCompileCommands(
+      llvm::StringRef FilePath) const;
+
+  virtual std::vector<std::string> getAllFiles() const;
+
+  /// \brief The number of PCHs built, and of files using one.
+  unsigned numBuilt() const { return Built; }
+  unsigned numCovered() const { return Pchs.size(); }
+
+ private:
+  const tooling::CompilationDatabase &Base;
+  std::string Dir;
+  // Absolute source path to the PCH it uses.
+  std::map<std::string, std::string> Pchs;
+  unsigned Built;
+};
+
+} // end namespace checks
+} // end namespace clang
+
+#endif // LLVM_TOOLS_EXTRA_CHECKS_PCHCOMPILATIONDATABASE_H
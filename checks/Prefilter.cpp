@@ -0,0 +1,108 @@
+//===-- checks/Prefilter.cpp - Skip files a check can't match -------------===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "Prefilter.h"
+#include "clang/Basic/LangOptions.h"
+#include "clang/Lex/Lexer.h"
+#include "clang/Tooling/Tooling.h"
+#include "llvm/ADT/OwningPtr.h"
+#include "llvm/ADT/SmallString.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Path.h"
+#include "llvm/Support/system_error.h"
+
+#include <algorithm>
+
+namespace clang {
+namespace checks {
+
+// Lexes File for Identifiers, adding the files it includes with quotes to
+// Includes if it is given.  Returns true on a match.
+static bool lexFile(llvm::StringRef File,
+                    llvm::ArrayRef<std::string> Identifiers,
+                    std::vector<std::string> *Includes) {
+  llvm::OwningPtr<llvm::MemoryBuffer> Buffer;
+  if (llvm::MemoryBuffer::getFile(File, Buffer))
+    return true;
+
+  LangOptions LangOpts;
+  LangOpts.CPlusPlus = 1;
+  Lexer RawLex(SourceLocation(), LangOpts, Buffer->getBufferStart(),
+               Buffer->getBufferStart(), Buffer->getBufferEnd());
+  // Where in "# include "file"" the last tokens were.
+  enum { None, Hash, Include } Directive = None;
+  Token Tok;
+  while (!RawLex.LexFromRawLexer(Tok)) {
+    if (Tok.is(tok::hash) && Tok.isAtStartOfLine()) {
+      Directive = Hash;
+      continue;
+    }
+    if (Tok.is(tok::raw_identifier)) {
+      llvm::StringRef Name(Tok.getRawIdentifierData(), Tok.getLength());
+      if (std::find(Identifiers.begin(), Identifiers.end(), Name) !=
+          Identifiers.end())
+        return true;
+      if (Directive == Hash && (Name == "include" || Name == "import")) {
+        Directive = Include;
+        continue;
+      }
+    } else if (Directive == Include && Includes &&
+               Tok.is(tok::string_literal) && Tok.getLength() > 2) {
+      llvm::StringRef Name(Tok.getLiteralData() + 1, Tok.getLength() - 2);
+      llvm::SmallString<256> Path;
+      if (!llvm::sys::path::is_absolute(Name))
+        Path = llvm::sys::path::parent_path(File);
+      llvm::sys::path::append(Path, Name);
+      Includes->push_back(Path.str());
+    }
+    Directive = None;
+  }
+  // The last token: the lexer returns it along with eof.
+  if (Tok.is(tok::raw_identifier)) {
+    llvm::StringRef Name(Tok.getRawIdentifierData(), Tok.getLength());
+    return std::find(Identifiers.begin(), Identifiers.end(), Name) !=
+           Identifiers.end();
+  }
+  return false;
+}
+
+bool mentionsAny(llvm::StringRef File,
+                 llvm::ArrayRef<std::string> Identifiers,
+                 bool FollowIncludes) {
+  std::vector<std::string> Includes;
+  if (lexFile(File, Identifiers, FollowIncludes ? &Includes : NULL))
+    return true;
+  // Only directly included headers; one that isn't there is likely found
+  // through an include path, and not one of ours.
+  for (unsigned I = 0, E = Includes.size(); I != E; ++I) {
+    if (llvm::sys::fs::exists(Includes[I]) &&
+        lexFile(Includes[I], Identifiers, NULL))
+      return true;
+  }
+  return false;
+}
+
+unsigned prefilter(llvm::ArrayRef<std::string> SourcePaths,
+                   llvm::ArrayRef<std::string> Identifiers,
+                   bool FollowIncludes,
+                   std::vector<std::string> &Kept) {
+  unsigned Skipped = 0;
+  for (unsigned I = 0, E = SourcePaths.size(); I != E; ++I) {
+    std::string File = tooling::getAbsolutePath(SourcePaths[I]);
+    if (mentionsAny(File, Identifiers, FollowIncludes))
+      Kept.push_back(File);
+    else
+      ++Skipped;
+  }
+  return Skipped;
+}
+
+} // end namespace checks
+} // end namespace clang
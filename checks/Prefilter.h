@@ -0,0 +1,46 @@
+//===-- checks/Prefilter.h - Skip files a check can't match -----*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+//  Most checks can only match where some identifier is spelled out, such as
+//  c_str for remove-cstr-calls.  Raw-lexing a file for it costs a fraction
+//  of parsing the file, and a file without it can be skipped.  An
+//  identifier made up by a macro from a header that isn't lexed is missed.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_TOOLS_EXTRA_CHECKS_PREFILTER_H
+#define LLVM_TOOLS_EXTRA_CHECKS_PREFILTER_H
+
+#include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/StringRef.h"
+
+#include <string>
+#include <vector>
+
+namespace clang {
+namespace checks {
+
+/// \brief Returns true if any of Identifiers is in File or, with
+/// FollowIncludes, in a file it #includes with quotes.  A file that can't
+/// be read counts as a match, so it is never skipped unchecked.
+bool mentionsAny(llvm::StringRef File,
+                 llvm::ArrayRef<std::string> Identifiers,
+                 bool FollowIncludes);
+
+/// \brief Moves the paths in SourcePaths that mention any of Identifiers to
+/// Kept, made absolute.  Returns the number skipped.
+unsigned prefilter(llvm::ArrayRef<std::string> SourcePaths,
+                   llvm::ArrayRef<std::string> Identifiers,
+                   bool FollowIncludes,
+                   std::vector<std::string> &Kept);
+
+} // end namespace checks
+} // end namespace clang
+
+#endif // LLVM_TOOLS_EXTRA_CHECKS_PREFILTER_H
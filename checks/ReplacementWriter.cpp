@@ -0,0 +1,185 @@
+//===-- checks/ReplacementWriter.cpp - Write edits file by file -----------===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "ReplacementWriter.h"
+#include "clang/Tooling/Tooling.h"
+#include "llvm/ADT/OwningPtr.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/raw_ostream.h"
+#include "llvm/Support/system_error.h"
+
+#include <algorithm>
+
+namespace clang {
+namespace checks {
+
+using tooling::Replacement;
+
+// Two edits overlap if their ranges do, or if both insert at one place,
+// where the order they go in would be a guess.
+static bool overlaps(const Replacement &A, const Replacement &B) {
+  if (A.getOffset() == B.getOffset())
+    return true;
+  return A.getOffset() < B.getOffset() + B.getLength() &&
+         B.getOffset() < A.getOffset() + A.getLength();
+}
+
+static void describe(llvm::raw_ostream &OS, const Replacement &R) {
+  OS << R.getOffset() << ":" << R.getLength() << ":\""
+     << R.getReplacementText() << "\"";
+}
+
+// Orders unsettled edits by translation unit, then by place in the file.
+static bool earlier(const std::pair<unsigned, Replacement> &A,
+                    const std::pair<unsigned, Replacement> &B) {
+  if (A.first != B.first)
+    return A.first < B.first;
+  return Replacement::Less()(A.second, B.second);
+}
+
+ReplacementWriter::ReplacementWriter(llvm::ArrayRef<std::string> SourcePaths)
+    : SourcePaths(SourcePaths.begin(), SourcePaths.end()), Written(0),
+      Conflicts(0) {
+  for (unsigned I = 0, E = SourcePaths.size(); I != E; ++I)
+    SourceIndex[SourcePaths[I]] = I;
+}
+
+int ReplacementWriter::add(unsigned TU, const tooling::Replacements &Replace) {
+  for (tooling::Replacements::const_iterator I = Replace.begin(),
+                                             E = Replace.end();
+       I != E; ++I) {
+    std::string File = tooling::getAbsolutePath(I->getFilePath());
+    Replacement R(File, I->getOffset(), I->getLength(),
+                  I->getReplacementText());
+    std::map<std::string, FileEdits>::const_iterator Made = Done.find(File);
+    if (Made != Done.end()) {
+      if (!Made->second.count(R))
+        reportForeign(R, TU);
+      continue;
+    }
+    Pending[File].push_back(std::make_pair(TU, R));
+  }
+  return write(SourcePaths[TU]);
+}
+
+int ReplacementWriter::finish() {
+  int Result = 0;
+  while (!Pending.empty()) {
+    if (write(Pending.begin()->first) != 0)
+      Result = 1;
+  }
+  return Result;
+}
+
+void ReplacementWriter::keep(FileEdits &Kept, const Edit &E) {
+  const Replacement &R = E.second;
+  // The same edit from another translation unit.
+  if (Kept.count(R))
+    return;
+
+  // The edits kept never overlap, so only the one before R and the first
+  // one starting inside it need a look.
+  FileEdits::const_iterator I = Kept.lower_bound(R);
+  FileEdits::const_iterator Overlapping = Kept.end();
+  if (I != Kept.end() && overlaps(I->first, R))
+    Overlapping = I;
+  if (I != Kept.begin()) {
+    --I;
+    if (overlaps(I->first, R))
+      Overlapping = I;
+  }
+  if (Overlapping == Kept.end()) {
+    Kept.insert(std::make_pair(R, E.first));
+    return;
+  }
+
+  ++Conflicts;
+  llvm::errs() << "Conflicting replacements in " << R.getFilePath()
+               << ":\n  kept ";
+  describe(llvm::errs(), Overlapping->first);
+  llvm::errs() << " from " << SourcePaths[Overlapping->second]
+               << "\n  dropped ";
+  describe(llvm::errs(), R);
+  llvm::errs() << " from " << SourcePaths[E.first] << "\n";
+}
+
+void ReplacementWriter::reportForeign(const Replacement &R, unsigned TU) {
+  ++Conflicts;
+  llvm::errs() << "Replacement in " << R.getFilePath() << " from "
+               << SourcePaths[TU] << " was not made by the file itself: ";
+  describe(llvm::errs(), R);
+  llvm::errs() << "\n";
+}
+
+int ReplacementWriter::write(const std::string &File) {
+  std::vector<Edit> Edits;
+  std::map<std::string, std::vector<Edit> >::iterator Found =
+      Pending.find(File);
+  if (Found != Pending.end()) {
+    Edits.swap(Found->second);
+    Pending.erase(Found);
+  }
+  std::sort(Edits.begin(), Edits.end(), earlier);
+
+  // A source file keeps only its own translation unit's edits; the others
+  // are checked against them once those are known.
+  std::map<std::string, unsigned>::const_iterator Source =
+      SourceIndex.find(File);
+  std::vector<Edit> Foreign;
+  FileEdits Kept;
+  for (unsigned I = 0, E = Edits.size(); I != E; ++I) {
+    if (Source != SourceIndex.end() && Edits[I].first != Source->second)
+      Foreign.push_back(Edits[I]);
+    else
+      keep(Kept, Edits[I]);
+  }
+  for (unsigned I = 0, E = Foreign.size(); I != E; ++I) {
+    if (!Kept.count(Foreign[I].second))
+      reportForeign(Foreign[I].second, Foreign[I].first);
+  }
+  if (Source != SourceIndex.end())
+    Done[File] = Kept;
+  if (Kept.empty())
+    return 0;
+  ++Written;
+
+  llvm::OwningPtr<llvm::MemoryBuffer> Buffer;
+  if (llvm::MemoryBuffer::getFile(File, Buffer)) {
+    llvm::errs() << "Could not read " << File << "\n";
+    return 1;
+  }
+  // Edits are ordered by offset; apply them from the end so the offsets of
+  // the ones before stay valid.
+  std::string Code = Buffer->getBuffer();
+  for (FileEdits::reverse_iterator I = Kept.rbegin(), E = Kept.rend();
+       I != E; ++I) {
+    const Replacement &R = I->first;
+    if (R.getOffset() + R.getLength() > Code.size()) {
+      llvm::errs() << "Skipped a replacement past the end of " << File
+                   << "\n";
+      continue;
+    }
+    Code.replace(R.getOffset(), R.getLength(), R.getReplacementText());
+  }
+
+  // Overwrite the file itself, as Rewriter::overwriteChangedFiles does, so
+  // symlinks, hard links and the file's mode are kept.
+  std::string ErrorInfo;
+  llvm::raw_fd_ostream FileStream(File.c_str(), ErrorInfo,
+                                  llvm::raw_fd_ostream::F_Binary);
+  if (!ErrorInfo.empty()) {
+    llvm::errs() << "Could not write " << File << ": " << ErrorInfo << "\n";
+    return 1;
+  }
+  FileStream << Code;
+  return 0;
+}
+
+} // end namespace checks
+} // end namespace clang
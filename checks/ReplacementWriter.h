@@ -0,0 +1,83 @@
+//===-- checks/ReplacementWriter.h - Write edits file by file ---*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+//  Collecting every replacement of a run before applying any of them needs
+//  memory for the whole run.  A ReplacementWriter is given each translation
+//  unit's replacements as it finishes, and writes a file as soon as no
+//  translation unit still to come can edit it: a source file once its own
+//  translation unit is done, and a header, which any of them may include,
+//  at the end.
+//
+//  The edits to a header are settled when it is written, in translation
+//  unit order: an edit is made unless it overlaps one from an earlier
+//  translation unit, and the dropped edit is reported.  Identical edits are
+//  made once.  A source file takes its edits from its own translation unit;
+//  an edit another translation unit makes to it is reported unless its own
+//  made the same one.  Either way, which edits are made and which are
+//  reported does not depend on the order the translation units finish in.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_TOOLS_EXTRA_CHECKS_REPLACEMENTWRITER_H
+#define LLVM_TOOLS_EXTRA_CHECKS_REPLACEMENTWRITER_H
+
+#include "clang/Tooling/Refactoring.h"
+#include "llvm/ADT/ArrayRef.h"
+
+#include <map>
+#include <string>
+#include <vector>
+
+namespace clang {
+namespace checks {
+
+class ReplacementWriter {
+ public:
+  /// \brief SourcePaths are the absolute paths of the translation units,
+  /// which are numbered by their place in it.
+  explicit ReplacementWriter(llvm::ArrayRef<std::string> SourcePaths);
+
+  /// \brief Adds the replacements translation unit TU made, and writes
+  /// any file no other translation unit can edit.  Call it once for every
+  /// translation unit, with no replacements if TU failed.  Must be called with
+  /// the working directory TU's paths are relative to.  Returns non-zero
+  /// if a file could not be written.
+  int add(unsigned TU, const tooling::Replacements &Replace);
+
+  /// \brief Writes the remaining files, in path order.
+  int finish();
+
+  unsigned numWritten() const { return Written; }
+  unsigned numConflicts() const { return Conflicts; }
+
+ private:
+  // The edits kept for a file, and the translation unit each came from.
+  typedef std::map<tooling::Replacement, unsigned,
+                   tooling::Replacement::Less> FileEdits;
+  // An edit not yet settled, and the translation unit that made it.
+  typedef std::pair<unsigned, tooling::Replacement> Edit;
+
+  void keep(FileEdits &Kept, const Edit &E);
+  void reportForeign(const tooling::Replacement &R, unsigned TU);
+  int write(const std::string &File);
+
+  std::vector<std::string> SourcePaths;
+  std::map<std::string, unsigned> SourceIndex;
+  std::map<std::string, std::vector<Edit> > Pending;
+  // The edits made to each source file already written, to tell edits
+  // other translation units make to it later apart from its own.
+  std::map<std::string, FileEdits> Done;
+  unsigned Written;
+  unsigned Conflicts;
+};
+
+} // end namespace checks
+} // end namespace clang
+
+#endif // LLVM_TOOLS_EXTRA_CHECKS_REPLACEMENTWRITER_H
@@ -0,0 +1,103 @@
+//===-- checks/StringEmptyCheck.cpp - size() == 0 to empty() --------------===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "StringEmptyCheck.h"
+#include "clang/AST/ASTContext.h"
+#include "clang/ASTMatchers/ASTMatchers.h"
+#include "clang/Basic/SourceManager.h"
+#include "clang/Lex/Lexer.h"
+#include "llvm/ADT/OwningPtr.h"
+
+using namespace clang::ast_matchers;
+using clang::tooling::Replacement;
+
+namespace clang {
+namespace checks {
+
+void FixStringEmpty::run(const ast_matchers::MatchFinder::MatchResult &Result) {
+  const BinaryOperator *Compare =
+      Result.Nodes.getStmtAs<BinaryOperator>("compare");
+  const Expr *Arg =
+      Result.Nodes.getStmtAs<Expr>("arg");
+  const bool Arrow =
+      Result.Nodes.getStmtAs<MemberExpr>("member")->isArrow();
+  // The 0 is converted to the size type, so look through the cast.
+  const IntegerLiteral *Zero = dyn_cast<IntegerLiteral>(
+      Result.Nodes.getStmtAs<Expr>("zero")->IgnoreImpCasts());
+  if (!Zero || Zero->getValue() != 0)
+    return;
+  // Leave comparisons spelled by macros alone.
+  if (Compare->getLocStart().isMacroID() || Compare->getLocEnd().isMacroID())
+    return;
+
+  // The object is a postfix expression, or it couldn't be called on, so
+  // it needs no parens in front of ".empty()".
+  StringRef ArgText = Lexer::getSourceText(
+      CharSourceRange::getTokenRange(Arg->getSourceRange()),
+      *Result.SourceManager, Result.Context->getLangOpts());
+  if (ArgText.empty()) return;
+
+  std::string Text = Compare->getOpcode() == BO_NE ? "!" : "";
+  Text += ArgText;
+  Text += Arrow ? "->empty()" : ".empty()";
+  Replace->insert(Replacement(*Result.SourceManager, Compare, Text));
+}
+
+static const char *StringSizeMethod =
+    "::std::basic_string<char, std::char_traits<char>, std::allocator<char> >"
+    "::size";
+
+static const char *StringLengthMethod =
+    "::std::basic_string<char, std::char_traits<char>, std::allocator<char> >"
+    "::length";
+
+void addStringEmptyMatchers(ast_matchers::MatchFinder &Finder,
+                            FixStringEmpty &Callback) {
+  Finder.addMatcher(
+      id("compare", binaryOperator(
+          anyOf(hasOperatorName("=="), hasOperatorName("!=")),
+          // The left-hand side must have the form x.size() or p->size(),
+          // or the same with length(), on a string.
+          hasLHS(memberCall(
+              callee(id("member", memberExpression())),
+              callee(method(anyOf(hasName(StringSizeMethod),
+                                  hasName(StringLengthMethod)))),
+              on(id("arg", expression())))),
+          // The right-hand side is checked for a literal 0 in the
+          // callback, past the conversion to the size type.
+          hasRHS(id("zero", expression())))),
+      &Callback);
+}
+
+namespace {
+class StringEmptyCheck : public Check {
+ public:
+  virtual void registerMatchers(ast_matchers::MatchFinder &Finder,
+                                tooling::Replacements *Replace) {
+    Callback.reset(new FixStringEmpty(Replace));
+    addStringEmptyMatchers(Finder, *Callback);
+  }
+
+  virtual bool getTriggers(std::vector<std::string> &Identifiers) const {
+    Identifiers.push_back("size");
+    Identifiers.push_back("length");
+    return true;
+  }
+
+ private:
+  llvm::OwningPtr<FixStringEmpty> Callback;
+};
+} // end namespace
+
+Check *createStringEmptyCheck() {
+  return new StringEmptyCheck();
+}
+
+} // end namespace checks
+} // end namespace clang
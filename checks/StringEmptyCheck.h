@@ -0,0 +1,45 @@
+//===-- checks/StringEmptyCheck.h - size() == 0 to empty() ------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+//  Matches comparisons of a string's size() or length() with 0, and
+//  replaces them with a call of empty().
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_TOOLS_EXTRA_CHECKS_STRINGEMPTYCHECK_H
+#define LLVM_TOOLS_EXTRA_CHECKS_STRINGEMPTYCHECK_H
+
+#include "Check.h"
+
+namespace clang {
+namespace checks {
+
+class FixStringEmpty : public ast_matchers::MatchFinder::MatchCallback {
+ public:
+  FixStringEmpty(tooling::Replacements *Replace)
+      : Replace(Replace) {}
+
+  virtual void run(const ast_matchers::MatchFinder::MatchResult &Result);
+
+ private:
+  tooling::Replacements *Replace;
+};
+
+/// \brief Adds the matchers for size() and length() compared with 0,
+/// which report to Callback.
+void addStringEmptyMatchers(ast_matchers::MatchFinder &Finder,
+                            FixStringEmpty &Callback);
+
+/// \brief The same, as a Check.
+Check *createStringEmptyCheck();
+
+} // end namespace checks
+} // end namespace clang
+
+#endif // LLVM_TOOLS_EXTRA_CHECKS_STRINGEMPTYCHECK_H
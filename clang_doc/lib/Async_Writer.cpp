@@ -0,0 +1,197 @@
+/* -*- Mode: C++ -*-
+//
+// \file: Async_Writer.cpp
+//
+// \date: 20 Oct 2026 08:14:37 UTC
+//
+*/
+
+#include "Async_Writer.h"
+#include "Utils.h"
+
+#include <iostream>
+
+namespace clang_doc {
+
+Async_Writer::Async_Writer(unsigned threads, size_t queue_depth)
+  : queue_depth_(queue_depth ? queue_depth : 1),
+    stopping_(false),
+    finished_(false),
+    paused_(false),
+    active_(0),
+    written_(0),
+    skipped_(0),
+    submitted_(0),
+    waits_(0),
+    wait_seconds_(0),
+    peak_depth_(0) {
+  pthread_mutex_init(&mutex_, 0);
+  pthread_cond_init(&not_empty_, 0);
+  pthread_cond_init(&not_full_, 0);
+  pthread_cond_init(&idle_, 0);
+
+  for (unsigned i = 0; i < threads; ++i) {
+    pthread_t thread;
+    if (pthread_create(&thread, 0, thread_main, this) != 0) {
+      std::cerr << "error: could not start writer thread, writing synchronously\n";
+      break;
+    }
+    threads_.push_back(thread);
+  }
+}
+
+Async_Writer::~Async_Writer(void) {
+  finish();
+  pthread_cond_destroy(&idle_);
+  pthread_cond_destroy(&not_full_);
+  pthread_cond_destroy(&not_empty_);
+  pthread_mutex_destroy(&mutex_);
+}
+
+void*
+Async_Writer::thread_main(void* arg) {
+  static_cast<Async_Writer*>(arg)->run();
+  return 0;
+}
+
+void
+Async_Writer::run(void) {
+  Output_Writer out;
+  pthread_mutex_lock(&mutex_);
+  while (true) {
+    while ((queue_.empty() && !stopping_) || paused_)
+      pthread_cond_wait(&not_empty_, &mutex_);
+    if (queue_.empty())
+      break;
+
+    Item item;
+    item.filename.swap(queue_.front().filename);
+    item.data.swap(queue_.front().data);
+    item.tmp.swap(queue_.front().tmp);
+    item.source.swap(queue_.front().source);
+    queue_.pop_front();
+    pthread_cond_signal(&not_full_);
+    ++active_;
+
+    pthread_mutex_unlock(&mutex_);
+    double start = wall_time();
+    write(out, item);
+    double seconds = wall_time() - start;
+    pthread_mutex_lock(&mutex_);
+    if (--active_ == 0)
+      pthread_cond_broadcast(&idle_);
+    if (!item.source.empty())
+      write_seconds_[item.source] = seconds;
+  }
+  written_ += out.written();
+  skipped_ += out.skipped();
+  pthread_mutex_unlock(&mutex_);
+}
+
+void
+Async_Writer::write(Output_Writer& out, const Item& item) {
+  if (item.tmp.empty())
+    out.write_if_changed(item.filename, item.data);
+  else
+    out.commit_temp(item.tmp, item.filename);
+}
+
+void
+Async_Writer::submit(const std::string& filename, std::string& data,
+                     const std::string& source) {
+  Item item;
+  item.filename = filename;
+  item.data.swap(data);
+  item.source = source;
+  enqueue(item);
+}
+
+void
+Async_Writer::submit_temp(const std::string& tmp, const std::string& filename,
+                          const std::string& source) {
+  Item item;
+  item.filename = filename;
+  item.tmp = tmp;
+  item.source = source;
+  enqueue(item);
+}
+
+void
+Async_Writer::enqueue(Item& item) {
+  ++submitted_;
+  if (threads_.empty()) {
+    double start = wall_time();
+    write(sync_, item);
+    if (!item.source.empty())
+      write_seconds_[item.source] = wall_time() - start;
+    return;
+  }
+
+  pthread_mutex_lock(&mutex_);
+  if (queue_.size() >= queue_depth_) {
+    ++waits_;
+    double start = wall_time();
+    while (queue_.size() >= queue_depth_)
+      pthread_cond_wait(&not_full_, &mutex_);
+    wait_seconds_ += wall_time() - start;
+  }
+  queue_.push_back(Item());
+  queue_.back().filename.swap(item.filename);
+  queue_.back().data.swap(item.data);
+  queue_.back().tmp.swap(item.tmp);
+  queue_.back().source.swap(item.source);
+  if (queue_.size() > peak_depth_)
+    peak_depth_ = queue_.size();
+  pthread_cond_signal(&not_empty_);
+  pthread_mutex_unlock(&mutex_);
+}
+
+void
+Async_Writer::finish(void) {
+  if (finished_)
+    return;
+  finished_ = true;
+
+  pthread_mutex_lock(&mutex_);
+  stopping_ = true;
+  pthread_cond_broadcast(&not_empty_);
+  pthread_mutex_unlock(&mutex_);
+
+  for (std::vector<pthread_t>::iterator i = threads_.begin(),
+         e = threads_.end(); i != e; ++i)
+    pthread_join(*i, 0);
+
+  written_ += sync_.written();
+  skipped_ += sync_.skipped();
+}
+
+void
+Async_Writer::pause(void) {
+  if (threads_.empty())
+    return;
+  pthread_mutex_lock(&mutex_);
+  paused_ = true;
+  while (active_)
+    pthread_cond_wait(&idle_, &mutex_);
+  pthread_mutex_unlock(&mutex_);
+}
+
+void
+Async_Writer::resume(void) {
+  if (threads_.empty())
+    return;
+  pthread_mutex_lock(&mutex_);
+  paused_ = false;
+  pthread_cond_broadcast(&not_empty_);
+  pthread_mutex_unlock(&mutex_);
+}
+
+void
+Async_Writer::print_stats(std::ostream& os) const {
+  os << "writer: " << submitted_ << " pages on " << threads_.size()
+     << " threads, queue full " << waits_ << " times ("
+     << static_cast<unsigned>(wait_seconds_ * 1000) << " ms waiting), peak depth "
+     << peak_depth_ << " of " << queue_depth_ << "\n";
+}
+
+} // clang_doc
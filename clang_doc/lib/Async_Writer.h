@@ -0,0 +1,110 @@
+/* -*- Mode: C++ -*-
+//
+// \file: Async_Writer.h
+//
+// \date: 20 Oct 2026 08:14:09 UTC
+//
+// Writes finished pages on separate threads, so parsing and rendering
+// carry on while pages go out to (possibly slow, e.g., NFS) disk.  Pages
+// go through a bounded queue; when it is full, submit() waits, and those
+// waits are counted so the queue and thread count can be tuned.
+//
+*/
+
+#ifndef INCLUDED_ASYNC_WRITER_H
+#define INCLUDED_ASYNC_WRITER_H
+
+#include "Output_Writer.h"
+
+#include <deque>
+#include <map>
+#include <ostream>
+#include <pthread.h>
+#include <string>
+#include <vector>
+
+namespace clang_doc {
+
+class Async_Writer {
+public:
+  // with no threads, submit() writes the page itself
+  Async_Writer(unsigned threads, size_t queue_depth);
+  ~Async_Writer(void);
+
+  // queue data to be written to filename; data is taken over (swapped
+  // with an empty string) rather than copied.  the time taken is
+  // recorded against source, if given.
+  void submit(const std::string& filename, std::string& data,
+              const std::string& source = std::string());
+  // as submit(), for contents already streamed to tmp (see
+  // Output_Writer::open_temp()); only the compare and the rename are
+  // left to do
+  void submit_temp(const std::string& tmp, const std::string& filename,
+                   const std::string& source = std::string());
+
+  // wait for everything queued to be written, and stop the threads
+  void finish(void);
+
+  // hold the threads between pages, e.g. so the process can fork with
+  // none of them inside malloc or stdio; pause() returns once they're
+  // all waiting
+  void pause(void);
+  void resume(void);
+
+  // valid after finish()
+  unsigned written(void) const {return written_;}
+  unsigned skipped(void) const {return skipped_;}
+  void print_stats(std::ostream& os) const;
+  // seconds spent writing each source's page
+  const std::map<std::string, double>& write_seconds(void) const {
+    return write_seconds_;
+  }
+
+private:
+  Async_Writer(const Async_Writer&);
+  Async_Writer& operator=(const Async_Writer&);
+
+  struct Item {
+    std::string filename;
+    std::string data;
+    // if set, the contents are in this file instead of data
+    std::string tmp;
+    std::string source;
+  };
+
+  static void* thread_main(void* arg);
+  void run(void);
+  // takes item over
+  void enqueue(Item& item);
+  static void write(Output_Writer& out, const Item& item);
+
+  size_t queue_depth_;
+  std::deque<Item> queue_;
+  std::vector<pthread_t> threads_;
+  bool stopping_;
+  bool finished_;
+  bool paused_;
+  // threads writing a page
+  unsigned active_;
+
+  pthread_mutex_t mutex_;
+  pthread_cond_t not_empty_;
+  pthread_cond_t not_full_;
+  pthread_cond_t idle_;
+
+  Output_Writer sync_;
+  unsigned written_;
+  unsigned skipped_;
+
+  // backpressure
+  unsigned submitted_;
+  unsigned waits_;
+  double wait_seconds_;
+  size_t peak_depth_;
+
+  std::map<std::string, double> write_seconds_;
+};
+
+} // clang_doc
+
+#endif /* INCLUDED_ASYNC_WRITER_H */
@@ -0,0 +1,110 @@
+/* -*- Mode: C++ -*-
+//
+// \file: Bloom_Filter.cpp
+//
+// \date: 19 Oct 2026 20:41:30 UTC
+//
+*/
+
+#include "Bloom_Filter.h"
+#include "Utils.h"
+
+#include <string.h>
+
+namespace clang_doc {
+
+namespace {
+
+int
+hex_value(char c) {
+  if (c >= '0' && c <= '9')
+    return c - '0';
+  if (c >= 'a' && c <= 'f')
+    return c - 'a' + 10;
+  if (c >= 'A' && c <= 'F')
+    return c - 'A' + 10;
+  return -1;
+}
+
+} // anonymous namespace
+
+Bloom_Filter::Bloom_Filter(void)
+  : num_hashes_(0),
+    num_bits_(0) {}
+
+void
+Bloom_Filter::reset(size_t num_keys) {
+  // 10 bits per key and 7 hashes gives just under 1% false positives
+  size_t num_bits = num_keys * 10;
+  if (num_bits < 64)
+    num_bits = 64;
+  reset(7, (num_bits + 7) & ~static_cast<size_t>(7));
+}
+
+bool
+Bloom_Filter::reset(unsigned num_hashes, size_t num_bits) {
+  if (num_hashes == 0 || num_bits == 0)
+    return false;
+  num_hashes_ = num_hashes;
+  num_bits_ = num_bits;
+  bits_.assign((num_bits + 7) / 8, 0);
+  return true;
+}
+
+// double hashing: bit i is h1 + i * h2, with both halves taken from a
+// single 64 bit hash of the key
+void
+Bloom_Filter::add(const std::string& key) {
+  if (!num_bits_)
+    return;
+  unsigned long long h = hash_bytes(key.data(), key.length());
+  unsigned long long h1 = h & 0xffffffffULL;
+  unsigned long long h2 = (h >> 32) | 1;
+  for (unsigned i = 0; i < num_hashes_; ++i) {
+    size_t bit = (h1 + i * h2) % num_bits_;
+    bits_[bit >> 3] |= 1 << (bit & 7);
+  }
+}
+
+bool
+Bloom_Filter::may_contain(const std::string& key) const {
+  if (!num_bits_)
+    return true;
+  unsigned long long h = hash_bytes(key.data(), key.length());
+  unsigned long long h1 = h & 0xffffffffULL;
+  unsigned long long h2 = (h >> 32) | 1;
+  for (unsigned i = 0; i < num_hashes_; ++i) {
+    size_t bit = (h1 + i * h2) % num_bits_;
+    if (!(bits_[bit >> 3] & (1 << (bit & 7))))
+      return false;
+  }
+  return true;
+}
+
+std::string
+Bloom_Filter::hex(size_t offset, size_t len) const {
+  static const char digits[] = "0123456789abcdef";
+  std::string str;
+  for (size_t i = offset; i < offset + len && i < bits_.size(); ++i) {
+    str += digits[bits_[i] >> 4];
+    str += digits[bits_[i] & 0xf];
+  }
+  return str;
+}
+
+size_t
+Bloom_Filter::set_hex(size_t offset, const char* hex) {
+  size_t len = strlen(hex);
+  if (len % 2 != 0 || offset + len / 2 > bits_.size())
+    return 0;
+  for (size_t i = 0; i < len; i += 2) {
+    int hi = hex_value(hex[i]);
+    int lo = hex_value(hex[i+1]);
+    if (hi < 0 || lo < 0)
+      return 0;
+    bits_[offset + i / 2] = (hi << 4) | lo;
+  }
+  return len / 2;
+}
+
+} // clang_doc
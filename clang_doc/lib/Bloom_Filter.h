@@ -0,0 +1,51 @@
+/* -*- Mode: C++ -*-
+//
+// \file: Bloom_Filter.h
+//
+// \date: 19 Oct 2026 20:41:08 UTC
+//
+// A Bloom filter over symbol keys, stored in each tag file so that a
+// lookup can skip tag files that certainly don't define the key.
+//
+*/
+
+#ifndef INCLUDED_BLOOM_FILTER_H
+#define INCLUDED_BLOOM_FILTER_H
+
+#include <stddef.h>
+#include <string>
+#include <vector>
+
+namespace clang_doc {
+
+class Bloom_Filter {
+public:
+  Bloom_Filter(void);
+
+  // size the filter for num_keys keys, about 1% false positives
+  void reset(size_t num_keys);
+  // size the filter explicitly, e.g., when reading it back
+  bool reset(unsigned num_hashes, size_t num_bits);
+
+  void add(const std::string& key);
+  bool may_contain(const std::string& key) const;
+
+  unsigned num_hashes(void) const {return num_hashes_;}
+  size_t num_bits(void) const {return num_bits_;}
+  size_t num_bytes(void) const {return bits_.size();}
+
+  // hex encoding of len bytes of the bit array starting at offset
+  std::string hex(size_t offset, size_t len) const;
+  // decode hex into the bit array at offset; returns the number of bytes
+  // decoded, or 0 if hex is malformed or doesn't fit
+  size_t set_hex(size_t offset, const char* hex);
+
+private:
+  unsigned num_hashes_;
+  size_t num_bits_;
+  std::vector<unsigned char> bits_;
+};
+
+} // clang_doc
+
+#endif /* INCLUDED_BLOOM_FILTER_H */
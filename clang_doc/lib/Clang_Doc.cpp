@@ -0,0 +1,617 @@
+/* -*- Mode: C++ -*-
+//
+// \file: Clang_Doc.cpp
+//
+// \author: Don Allon Hinton <don.hinton@gmx.com>
+// \date: 13 Aug 2012 19:20:11 UTC
+//
+*/
+
+#include "Clang_Doc.h"
+#include "Async_Writer.h"
+#include "Gzip_Stream.h"
+#include "Http_Server.h"
+#include "Worker_Pool.h"
+#include "Render_Cache.h"
+#include "TU_File.h"
+#include "Token_Stream_Writer.h"
+#include "Utils.h"
+
+#include <iostream>
+#include <libgen.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+namespace clang_doc {
+
+namespace {
+
+struct Visitor_Data{
+  Clang_Doc* doc;
+  CXFile file;
+  const char* filename;
+  std::vector<Definition>* defs;
+};
+
+CXChildVisitResult
+visitor_c(CXCursor cursor, CXCursor parent, CXClientData client_data) {
+  Clang_Doc* d = (static_cast<Visitor_Data*>(client_data))->doc;
+  return d->visitor(cursor, parent, client_data);
+}
+
+void
+send_cost(double seconds, unsigned tokens) {
+  char buf[64];
+  snprintf(buf, sizeof(buf), "%.6f %u", seconds, tokens);
+  Worker_Pool::send(Worker_Pool::Msg_Cost, buf);
+}
+
+} // anonymous namespace
+
+// Phase one in the worker pool: find each file's definitions
+class Clang_Doc::Definitions_Job : public Worker_Pool::Job {
+public:
+  explicit Definitions_Job(Clang_Doc& doc)
+    : files(doc.files_.begin(), doc.files_.end()),
+      doc_(doc) {}
+
+  void run(unsigned task, bool) {
+    Diagnostic_Store diags;
+    diags.set_min_severity(doc_.diags_.min_severity());
+    std::vector<Definition> defs;
+    double start = wall_time();
+    bool cached = false;
+    if (doc_.find_definitions(files[task], defs, diags, &cached)) {
+      std::string data;
+      Render_Cache::format_definitions(defs, data);
+      Worker_Pool::send(Worker_Pool::Msg_Def, data);
+      if (!cached)
+        send_cost(wall_time() - start, 0);
+    }
+    std::string data;
+    diags.serialize(data);
+    Worker_Pool::send(Worker_Pool::Msg_Diag, data);
+  }
+
+  // task n is the n'th file
+  std::vector<std::string> files;
+
+private:
+  Clang_Doc& doc_;
+};
+
+// Phase two in the worker pool: render each page.  Workers are forked
+// after the symbol table is complete, so they all share it.  Pages are
+// handed to the writer by the parent as they arrive; a rendered page
+// arrives as the temporary file the worker streamed it to.
+class Clang_Doc::Pages_Job : public Worker_Pool::Job {
+public:
+  explicit Pages_Job(Clang_Doc& doc)
+    : files(doc.files_.begin(), doc.files_.end()),
+      relinked(0),
+      doc_(doc) {}
+
+  void run(unsigned task, bool retry) {
+    Xref_Index xref;
+    Diagnostic_Store diags;
+    diags.set_min_severity(doc_.diags_.min_severity());
+
+    Html_File html_file =
+      Html_File(doc_.argc_, doc_.argv_, doc_.idx_, doc_.includes_, doc_.files_,
+                doc_.symbols_, files[task], doc_.object_dir_, doc_.html_dir_,
+                doc_.prefix_);
+    doc_.setup_html_file(html_file, &xref, &diags, &gzip_);
+    // a crash the first time round may have been a stale .tu file
+    html_file.set_reparse(retry);
+
+    // a rendered page is streamed to a temporary file, so it's never
+    // held whole; a relinked one is whole anyway
+    std::string page;
+    char how = 'c';
+    double start = wall_time();
+    if (doc_.relink_ && html_file.relink_page(page))
+      how = 'r';
+    else if (!html_file.create_temp(page))
+      how = 0;
+    if (how == 'c')
+      send_cost(wall_time() - start, html_file.num_tokens());
+    if (how) {
+      std::string data(1, how);
+      data += html_file.output_filename();
+      data += '\0';
+      data += page;
+      Worker_Pool::send(Worker_Pool::Msg_Page, data);
+    }
+
+    std::string data;
+    xref.serialize(data);
+    Worker_Pool::send(Worker_Pool::Msg_Xref, data);
+    data.clear();
+    diags.serialize(data);
+    Worker_Pool::send(Worker_Pool::Msg_Diag, data);
+  }
+
+  void done(unsigned task, Worker_Pool::Result& messages) {
+    for (Worker_Pool::Result::iterator i = messages.begin();
+         i != messages.end(); ) {
+      if ((*i).type != Worker_Pool::Msg_Page) {
+        ++i;
+        continue;
+      }
+      size_t nul = (*i).data.find('\0');
+      if (nul != std::string::npos) {
+        std::string filename = (*i).data.substr(1, nul - 1);
+        if ((*i).data[0] == 'r') {
+          ++relinked;
+          (*i).data.erase(0, nul + 1);
+          doc_.writer_->submit(filename, (*i).data, files[task]);
+        }
+        else
+          doc_.writer_->submit_temp((*i).data.substr(nul + 1), filename,
+                                    files[task]);
+      }
+      i = messages.erase(i);
+    }
+  }
+
+  // a fork while a writer thread is inside malloc or stdio could leave
+  // the worker with a lock nobody will release
+  void before_fork(void) {doc_.writer_->pause();}
+  void after_fork(void) {doc_.writer_->resume();}
+
+  std::vector<std::string> files;
+  unsigned relinked;
+
+private:
+  Clang_Doc& doc_;
+  Gzip_Stream gzip_;
+};
+
+CXChildVisitResult
+Clang_Doc::visitor(CXCursor cursor, CXCursor parent, CXClientData client_data) {
+  CXSourceLocation loc = clang_getCursorLocation(cursor);
+  CXFile cxfile;
+  unsigned line;
+  unsigned column;
+  unsigned offset;
+  clang_getExpansionLocation(loc, &cxfile, &line, &column, &offset);
+
+  Visitor_Data* vd = static_cast<Visitor_Data*>(client_data);
+
+  // we're just looking for definitions in this file, so
+  // skip included files for now
+  if (cxfile != vd->file)
+    return CXChildVisit_Continue;
+
+  if (clang_isDeclaration(cursor.kind)) {
+    if (clang_isCursorDefinition(cursor)) {
+      CXString cxusr = clang_getCursorUSR(cursor);
+      std::string susr = clang_getCString(cxusr);
+      // external linkage begins with "c:@", but not @aN, which is an anonymous
+      // namespace otherwise, it would be "c:somefile.cpp@..."
+      if (susr.length() >= 5 && susr[2] == '@' && !(susr.substr(2,3) == "@aN")) {
+        Definition def;
+        // can't use usr since you can only generate it for the defs, not declarations.
+        def.key = fullyScopedName(cursor);
+        def.file = vd->filename;
+        def.line = line;
+        def.column = column;
+        def.offset = offset;
+        def.from_tag_file = false;
+        vd->defs->push_back(def);
+      }
+      clang_disposeString(cxusr);
+    }
+  }
+
+  return CXChildVisit_Recurse;
+}
+
+Clang_Doc::Clang_Doc(int argc,
+                     char* argv[],
+                     const std::set<std::string>& files,
+                     const std::string& object_dir,
+                     const std::string& html_dir,
+                     const std::string& prefix)
+  : argc_(argc),
+    argv_(argv),
+    format_(Format_Html),
+    gzip_(false),
+    layout_(Layout_Flat),
+    relink_(false),
+    jobs_(0),
+    writers_(2),
+    write_queue_(32),
+    writer_(0),
+    files_ (files) {
+
+  object_dir_ = strip_final_seps(object_dir);
+  html_dir_ = strip_final_seps(html_dir);
+  prefix_ = strip_final_seps(prefix);
+
+  parse_include_directives();
+  idx_ = clang_createIndex(0, 0);
+
+  if (jobserver_.connect())
+    std::cout << "using the make jobserver\n";
+}
+
+unsigned
+Clang_Doc::num_workers(void) const {
+  // an explicit -j wins, even -j 1; the jobserver still gates workers
+  // beyond the first
+  if (jobs_)
+    return jobs_;
+  // make decides how many actually run at once
+  if (jobserver_.connected()) {
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    return cpus > 1 ? cpus : 1;
+  }
+  return 1;
+}
+
+Clang_Doc::~Clang_Doc(void) {
+  clang_disposeIndex(idx_);
+}
+
+void
+Clang_Doc::add_symbols(const std::set<std::string>& tags) {
+  //std::cout << "Clang_Doc::add_symbols\n";
+
+  std::cout << "tag files:\n";
+  for (std::set<std::string>::iterator i = tags.begin(),
+         e = tags.end(); i != e; ++i) {
+    // only the tag file's filter is read here, its symbols are read
+    // when a lookup might find something in it
+    if (symbols_.add_tag_file(*i))
+      std::cout << (*i).c_str() << "\n";
+  }
+  std::cout << std::endl;
+}
+
+void
+Clang_Doc::add_local_symbols(const std::vector<Definition>& defs) {
+  for (std::vector<Definition>::const_iterator i = defs.begin(),
+         e = defs.end(); i != e; ++i)
+    symbols_.add_local(*i);
+}
+
+bool
+Clang_Doc::find_definitions(const std::string& filename,
+                            std::vector<Definition>& defs,
+                            Diagnostic_Store& diags,
+                            bool* cached) {
+  std::string defs_file = make_filename(filename, object_dir_, prefix_, ".defs",
+                                       true, layout_);
+  if (relink_ && Render_Cache::read_definitions(defs_file, filename, defs)) {
+    if (cached)
+      *cached = true;
+    return true;
+  }
+
+  std::string stamp = Render_Cache::source_stamp(filename);
+  TU_File tu_file = TU_File (argc_, argv_, idx_, filename, object_dir_, prefix_,
+                             true, layout_);
+  tu_file.set_diagnostics(&diags);
+  CXTranslationUnit tu = tu_file.tu();
+  if (!tu) {
+    std::cerr << "error: failed to parse \"" << filename.c_str() << "\"\n";
+    return false;
+  }
+
+  CXFile file = clang_getFile(tu, filename.c_str());
+
+  Visitor_Data vd;
+  vd.doc = this;
+  vd.file = file;
+  vd.filename = filename.c_str();
+  vd.defs = &defs;
+
+  CXCursor c = clang_getTranslationUnitCursor(tu);
+  clang_visitChildren(c, visitor_c, &vd);
+
+  Render_Cache::write_definitions(defs_file, stamp, defs);
+  return true;
+}
+
+double
+Clang_Doc::predict(Cost_Model::Phase phase, const std::vector<std::string>& files,
+                   std::vector<unsigned>& order, unsigned workers) {
+  std::vector<double> predicted;
+  costs_.schedule(files, phase, order, predicted);
+  return Cost_Model::makespan(predicted, order, workers);
+}
+
+void
+Clang_Doc::record_cost(const std::string& file, Cost_Model::Phase phase,
+                       const std::string& data) {
+  double seconds;
+  unsigned tokens;
+  if (sscanf(data.c_str(), "%lf %u", &seconds, &tokens) != 2)
+    return;
+  costs_.record(file, phase, seconds);
+  if (tokens)
+    costs_.set_tokens(file, tokens);
+}
+
+void
+Clang_Doc::report_time(const char* phase, double predicted, double actual) {
+  char buf[128];
+  snprintf(buf, sizeof(buf), "%s: predicted %.1f s, took %.1f s\n", phase,
+           predicted, actual);
+  std::cout << buf;
+}
+
+void
+Clang_Doc::generate_symbol_table(const std::set<std::string>& tags) {
+  //std::cout << "Clang_Doc::generate_symbol_table\n";
+
+  add_symbols (tags);
+  costs_.read(costs_filename());
+
+  if (layout_ == Layout_Hashed) {
+    make_shard_dirs(object_dir_);
+    make_shard_dirs(html_dir_);
+  }
+
+  std::vector<std::string> files(files_.begin(), files_.end());
+  std::vector<unsigned> order;
+  double predicted = predict(Cost_Model::Parse, files, order, num_workers());
+  double start = wall_time();
+
+  if (num_workers() > 1) {
+    Definitions_Job job(*this);
+    Worker_Pool pool(num_workers());
+    if (jobserver_.connected())
+      pool.set_jobserver(&jobserver_);
+    std::vector<Worker_Pool::Result> results;
+    std::vector<bool> failed;
+    // the most expensive files first, so none is left running alone
+    pool.set_order(order);
+    pool.run(job, job.files.size(), results, failed);
+
+    // merge in file order, so the first definition of a key wins just as
+    // it does in a serial run
+    for (unsigned t = 0; t < results.size(); ++t) {
+      if (failed[t]) {
+        std::cerr << "error: skipping \"" << job.files[t].c_str()
+                  << "\", it crashed clang_doc twice\n";
+        continue;
+      }
+      for (Worker_Pool::Result::const_iterator i = results[t].begin(),
+             e = results[t].end(); i != e; ++i) {
+        if ((*i).type == Worker_Pool::Msg_Def) {
+          std::vector<Definition> defs;
+          Render_Cache::parse_definitions((*i).data, job.files[t], defs);
+          add_local_symbols(defs);
+        }
+        else if ((*i).type == Worker_Pool::Msg_Diag)
+          diags_.merge((*i).data);
+        else if ((*i).type == Worker_Pool::Msg_Cost)
+          record_cost(job.files[t], Cost_Model::Parse, (*i).data);
+      }
+    }
+  }
+  else {
+    for (std::set<std::string>::const_iterator i = files_.begin(),
+           e = files_.end(); i != e; ++i) {
+      std::vector<Definition> defs;
+      double file_start = wall_time();
+      bool cached = false;
+      if (find_definitions((*i), defs, diags_, &cached)) {
+        if (!cached)
+          costs_.record(*i, Cost_Model::Parse, wall_time() - file_start);
+        add_local_symbols(defs);
+      }
+    }
+  }
+  report_time("parse", predicted, wall_time() - start);
+
+  // the table is only read from here on, and page workers forked after
+  // this share it
+  if (!symbols_.freeze(prefix_, layout_))
+    std::cerr << "warning: no perfect hash for the symbol table, using a binary search\n";
+  std::vector<std::string> unreadable;
+  symbols_.unreadable_tag_files(unreadable);
+  for (std::vector<std::string>::const_iterator i = unreadable.begin(),
+         e = unreadable.end(); i != e; ++i)
+    std::cerr << "error: could not read tag file: " << (*i).c_str() << "\n";
+
+#if 0
+  std::cout << "\n\nList of definition with external linkage\n";
+
+  for (Symbol_Table::Definition_Map::const_iterator i = symbols_.local().begin(),
+         e = symbols_.local().end(); i != e; ++i) {
+    std::cout << (*i).second.file.c_str() << ":" << (*i).second.line;
+    std::cout << ":" << (*i).second.column << ":   " << (*i).second.key.c_str();
+    std::cout << "\n";
+  }
+  std::cout << std::endl;
+#endif
+}
+
+void
+Clang_Doc::generate_tag_file(const std::string& tag_file) {
+  char* buf = 0;
+  size_t len = 0;
+  FILE* f = tag_file.empty() ? 0 : open_memstream(&buf, &len);
+  if (f) {
+    std::vector<Definition> entries;
+    for (std::set<std::string>::const_iterator ci = files_.begin(),
+           ce = files_.end(); ci != ce; ++ci) {
+      Definition d;
+      d.key = (*ci);
+      d.file = make_filename((*ci), html_dir_, prefix_, ".html", true, layout_);
+      d.line = 0;
+      entries.push_back(d);
+    }
+    // definitions already in a tag file never make it into local()
+    for (Symbol_Table::Definition_Map::const_iterator i = symbols_.local().begin(),
+           e = symbols_.local().end(); i != e; ++i) {
+      if (!(*i).second.key.empty())
+        entries.push_back((*i).second);
+    }
+    Tag_File::write(f, entries, layout_);
+    fclose(f);
+    // rewriting an unchanged tag file would make everything that depends
+    // on it rebuild
+    output_.write_if_changed(tag_file, buf, len);
+    free(buf);
+  }
+  else
+    std::cerr << "error creating tag file: " << tag_file.c_str() << "\n";
+}
+
+void
+Clang_Doc::generate_html_files(const std::string& tag_file) {
+  if (format_ == Format_Token_Stream)
+    Token_Stream_Writer::write_script(html_dir_);
+
+  // one compressor, reset between pages
+  Gzip_Stream gzip;
+  unsigned relinked = 0;
+  Async_Writer writer(writers_, write_queue_);
+  writer_ = &writer;
+
+  std::vector<std::string> files(files_.begin(), files_.end());
+  std::vector<unsigned> order;
+  double predicted = predict(Cost_Model::Render, files, order, num_workers());
+  double start = wall_time();
+
+  if (num_workers() > 1) {
+    Pages_Job job(*this);
+    Worker_Pool pool(num_workers());
+    if (jobserver_.connected())
+      pool.set_jobserver(&jobserver_);
+    std::vector<Worker_Pool::Result> results;
+    std::vector<bool> failed;
+    pool.set_order(order);
+    pool.run(job, job.files.size(), results, failed);
+    relinked = job.relinked;
+
+    for (unsigned t = 0; t < results.size(); ++t) {
+      if (failed[t]) {
+        std::cerr << "error: skipping \"" << job.files[t].c_str()
+                  << "\", it crashed clang_doc twice\n";
+        continue;
+      }
+      for (Worker_Pool::Result::const_iterator i = results[t].begin(),
+             e = results[t].end(); i != e; ++i) {
+        if ((*i).type == Worker_Pool::Msg_Xref)
+          xref_.merge((*i).data);
+        else if ((*i).type == Worker_Pool::Msg_Diag)
+          diags_.merge((*i).data);
+        else if ((*i).type == Worker_Pool::Msg_Cost)
+          record_cost(job.files[t], Cost_Model::Render, (*i).data);
+      }
+    }
+  }
+  else {
+    for (std::set<std::string>::const_iterator i = files_.begin(),
+           e = files_.end();i != e; ++i) {
+      Html_File html_file =
+        Html_File(argc_, argv_, idx_, includes_, files_, symbols_,
+                  (*i), object_dir_, html_dir_, prefix_);
+      setup_html_file(html_file, &xref_, &diags_, &gzip);
+      html_file.set_output_writer(&writer);
+      std::string page;
+      double file_start = wall_time();
+      if (relink_ && html_file.relink_page(page)) {
+        ++relinked;
+        html_file.write_output(page);
+      }
+      else if (html_file.create_file()) {
+        costs_.record(*i, Cost_Model::Render, wall_time() - file_start);
+        costs_.set_tokens(*i, html_file.num_tokens());
+      }
+      else
+        std::cerr << "error: could not render file: "
+                  << html_file.output_filename().c_str() << "\n";
+    }
+  }
+  writer.finish();
+  writer_ = 0;
+  report_time("render", predicted, wall_time() - start);
+
+  const std::map<std::string, double>& writes = writer.write_seconds();
+  for (std::map<std::string, double>::const_iterator i = writes.begin(),
+         e = writes.end(); i != e; ++i)
+    costs_.record(i->first, Cost_Model::Write, i->second);
+  costs_.write(costs_filename());
+
+  generate_tag_file(tag_file);
+
+  std::cout << "wrote " << writer.written() + output_.written() << " files, "
+            << writer.skipped() + output_.skipped() << " unchanged\n";
+  writer.print_stats(std::cout);
+  if (relink_)
+    std::cout << "relinked " << relinked << " of " << files_.size()
+              << " pages from the render cache\n";
+  // tag files are read here when the table is frozen, before any page
+  // worker starts, so this holds with workers too
+  if (symbols_.num_tag_files())
+    std::cout << "read " << symbols_.num_loaded_tag_files() << " of "
+              << symbols_.num_tag_files() << " tag files\n";
+
+  if (!xref_file_.empty()) {
+    std::cout << "writing " << xref_.size() << " references to "
+              << xref_file_.c_str() << "\n";
+    xref_.write(xref_file_);
+    xref_.write_html(symbols_.local(), html_dir_, prefix_, layout_);
+  }
+}
+
+void
+Clang_Doc::setup_html_file(Html_File& html_file, Xref_Index* xref,
+                           Diagnostic_Store* diags, Gzip_Stream* gzip) {
+  if (!xref_file_.empty())
+    html_file.set_xref_index(xref);
+  html_file.set_diagnostics(diags);
+  html_file.set_format(format_);
+  html_file.set_layout(layout_);
+  if (gzip_)
+    html_file.set_gzip(gzip);
+}
+
+int
+Clang_Doc::serve(unsigned short port, size_t cache_bytes) {
+  if (format_ == Format_Token_Stream)
+    Token_Stream_Writer::write_script(html_dir_);
+
+  Http_Server server(*this, port, cache_bytes);
+  return server.run();
+}
+
+bool
+Clang_Doc::render_html_file(const std::string& source_filename, std::string& page) {
+  if (files_.find(source_filename) == files_.end())
+    return false;
+  Html_File html_file =
+    Html_File(argc_, argv_, idx_, includes_, files_, symbols_,
+              source_filename, object_dir_, html_dir_, prefix_);
+  html_file.set_format(format_);
+  html_file.set_layout(layout_);
+  return html_file.render(page);
+}
+
+void
+Clang_Doc::report_diagnostics(const std::string& diag_file) {
+  diags_.print(std::cerr);
+  if (!diag_file.empty())
+    diags_.write(diag_file);
+}
+
+void
+Clang_Doc::parse_include_directives (void) {
+  //std::cout << "parse_include_directives\n";
+
+  find_include_directories(argc_, argv_, includes_);
+
+  std::cout << "include paths:\n";
+  for (std::vector<std::string>::iterator i = includes_.begin(),
+         e = includes_.end(); i != e; ++i)
+    std::cout << (*i).c_str() << "\n";
+  std::cout << std::endl;
+}
+
+} // clang_doc
@@ -0,0 +1,157 @@
+/* -*- Mode: C -*-
+//
+// \file: Clang_Doc.h
+//
+// \author: Don Allon Hinton <don.hinton@gmx.com>
+// \date: 13 Aug 2012 19:19:58 UTC
+//
+*/
+
+#ifndef INCLUDED_CLANG_DOC_H
+#define INCLUDED_CLANG_DOC_H
+
+#include "clang-c/Index.h"
+#include "Cost_Model.h"
+#include "Diagnostic_Store.h"
+#include "Html_File.h"
+#include "Jobserver.h"
+#include "Output_Writer.h"
+#include "Symbol_Table.h"
+#include "Xref_Index.h"
+
+#include <set>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace clang_doc {
+
+class Async_Writer;
+class Gzip_Stream;
+
+class Clang_Doc {
+public:
+  Clang_Doc(int argc,
+            char* argv[],
+            const std::set<std::string>& files,
+            const std::string& object_dir,
+            const std::string& html_dir,
+            const std::string& prefix);
+
+  ~Clang_Doc(void);
+
+  const char* object_dir(void) const {return object_dir_.c_str();}
+  const char* html_dir(void) const {return html_dir_.c_str();}
+  const char* prefix(void) const {return prefix_.c_str();}
+
+  // write a cross-reference index to xref_file while generating html
+  void set_xref_file(const std::string& xref_file) {xref_file_ = xref_file;}
+
+  void set_format(Output_Format format) {format_ = format;}
+
+  // share symbol tables read from tag files with concurrent clang_doc
+  // processes through images in dir
+  void set_symtab_dir(const std::string& dir) {symbols_.set_image_dir(dir);}
+
+  // write each page as a gzip compressed .html.gz
+  void set_gzip(bool gzip) {gzip_ = gzip;}
+
+  // spread pages and object files over subdirectories, see Layout
+  void set_layout(Layout layout) {layout_ = layout;}
+  Layout layout(void) const {return layout_;}
+
+  // take definitions and pages from the caches left by an earlier run
+  // wherever the source hasn't changed since, so pages are only relinked
+  // against the current tag files rather than reparsed
+  void set_relink(bool relink) {relink_ = relink;}
+
+  // parse and render in this many worker processes, which also keeps a
+  // crash in libclang from ending the run.  under make -j, workers beyond
+  // the first also need a token from make's jobserver, and without
+  // set_jobs() there are up to one per cpu.  set_jobs(1) always renders
+  // in this process.
+  void set_jobs(unsigned jobs) {jobs_ = jobs;}
+
+  // write pages on threads threads, queueing up to queue_depth pages
+  // behind them; with no threads, pages are written as they're rendered.
+  void set_writers(unsigned threads, unsigned queue_depth) {
+    writers_ = threads;
+    write_queue_ = queue_depth;
+  }
+
+  void generate_symbol_table(const std::set<std::string>& tag_files);
+  void generate_html_files(const std::string& tag_file);
+
+  // render pages on demand instead of calling generate_html_files()
+  int serve(unsigned short port, size_t cache_bytes);
+  bool render_html_file(const std::string& source_filename, std::string& page);
+
+  const std::set<std::string>& files(void) const {return files_;}
+
+  Diagnostic_Store& diagnostics(void) {return diags_;}
+  // print the collected diagnostics, and optionally write them to diag_file
+  void report_diagnostics(const std::string& diag_file);
+
+  CXChildVisitResult visitor(CXCursor cursor,
+                             CXCursor parent,
+                             CXClientData client_data);
+
+private:
+  class Definitions_Job;
+  class Pages_Job;
+  friend class Definitions_Job;
+  friend class Pages_Job;
+
+  // cached is set if defs came from the .defs cache
+  bool find_definitions(const std::string& filename,
+                        std::vector<Definition>& defs,
+                        Diagnostic_Store& diags,
+                        bool* cached = 0);
+  void setup_html_file(Html_File& html_file, Xref_Index* xref,
+                       Diagnostic_Store* diags, Gzip_Stream* gzip);
+  void add_symbols(const std::set<std::string>& tags);
+  void add_local_symbols(const std::vector<Definition>& defs);
+  void generate_tag_file(const std::string& tag_file);
+  void parse_include_directives (void);
+  unsigned num_workers(void) const;
+
+  std::string costs_filename(void) const {return object_dir_ + "/clang_doc.costs";}
+  // order files most expensive first, and return the predicted wall time
+  // for workers to process them in that order
+  double predict(Cost_Model::Phase phase, const std::vector<std::string>& files,
+                 std::vector<unsigned>& order, unsigned workers);
+  // data is a worker's Worker_Pool::Msg_Cost
+  void record_cost(const std::string& file, Cost_Model::Phase phase,
+                   const std::string& data);
+  void report_time(const char* phase, double predicted, double actual);
+
+  int argc_;
+  char** argv_;
+  std::string object_dir_;
+  std::string html_dir_;
+  std::string prefix_;
+  std::string xref_file_;
+  Output_Format format_;
+  bool gzip_;
+  Layout layout_;
+  bool relink_;
+  unsigned jobs_;
+  unsigned writers_;
+  unsigned write_queue_;
+  Async_Writer* writer_;
+
+  CXIndex idx_;
+  const std::set<std::string> files_;
+  std::set<std::string> other_files_;
+  Symbol_Table symbols_;
+  std::vector<std::string> includes_;
+  Xref_Index xref_;
+  Diagnostic_Store diags_;
+  Output_Writer output_;
+  Cost_Model costs_;
+  Jobserver jobserver_;
+};
+
+} // clang_doc
+
+#endif /* INCLUDED_CLANG_DOC_H */
@@ -0,0 +1,167 @@
+/* -*- Mode: C++ -*-
+//
+// \file: Cost_Model.cpp
+//
+// \date: 20 Oct 2026 10:12:09 UTC
+//
+*/
+
+#include "Cost_Model.h"
+#include "Output_Writer.h"
+
+#include <algorithm>
+#include <functional>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/stat.h>
+
+namespace clang_doc {
+
+namespace {
+
+// until there's some history, a guess; only the ordering by size matters
+const double default_rate = 1e-6;
+
+unsigned long
+file_size(const std::string& file) {
+  struct stat st;
+  return stat(file.c_str(), &st) == 0 ? st.st_size : 0;
+}
+
+struct More_Expensive {
+  explicit More_Expensive(const std::vector<double>& seconds)
+    : seconds_(seconds) {}
+  bool operator()(unsigned a, unsigned b) const {
+    return seconds_[a] > seconds_[b];
+  }
+  const std::vector<double>& seconds_;
+};
+
+} // anonymous namespace
+
+Cost_Model::Cost_Model(void) {
+  for (int p = 0; p < Num_Phases; ++p)
+    rates_[p] = default_rate;
+}
+
+Cost_Model::Cost&
+Cost_Model::cost(const std::string& file) {
+  std::map<std::string, Cost>::iterator i = costs_.find(file);
+  if (i != costs_.end())
+    return i->second;
+  Cost c;
+  c.size = file_size(file);
+  for (int p = 0; p < Num_Phases; ++p)
+    c.seconds[p] = 0;
+  c.tokens = 0;
+  return costs_.insert(std::pair<std::string, Cost>(file, c)).first->second;
+}
+
+bool
+Cost_Model::read(const std::string& filename) {
+  FILE* f = fopen(filename.c_str(), "r");
+  if (!f)
+    return false;
+
+  char file[1024];
+  Cost c;
+  while (fscanf(f, "%lu %lf %lf %lf %u %1023s\n", &c.size, &c.seconds[Parse],
+                &c.seconds[Render], &c.seconds[Write], &c.tokens, file) == 6)
+    costs_[file] = c;
+  fclose(f);
+  update_rates();
+  return true;
+}
+
+bool
+Cost_Model::write(const std::string& filename) const {
+  char* buf = 0;
+  size_t len = 0;
+  FILE* f = open_memstream(&buf, &len);
+  if (!f)
+    return false;
+  for (std::map<std::string, Cost>::const_iterator i = costs_.begin(),
+         e = costs_.end(); i != e; ++i) {
+    const Cost& c = i->second;
+    fprintf(f, "%lu %.6f %.6f %.6f %u %s\n", c.size, c.seconds[Parse],
+            c.seconds[Render], c.seconds[Write], c.tokens, i->first.c_str());
+  }
+  fclose(f);
+  bool ok = Output_Writer().write_if_changed(filename, buf, len);
+  free(buf);
+  return ok;
+}
+
+void
+Cost_Model::update_rates(void) {
+  for (int p = 0; p < Num_Phases; ++p) {
+    double seconds = 0;
+    double bytes = 0;
+    for (std::map<std::string, Cost>::const_iterator i = costs_.begin(),
+           e = costs_.end(); i != e; ++i) {
+      if (i->second.seconds[p] > 0) {
+        seconds += i->second.seconds[p];
+        bytes += i->second.size;
+      }
+    }
+    rates_[p] = bytes > 0 ? seconds / bytes : default_rate;
+  }
+}
+
+void
+Cost_Model::record(const std::string& file, Phase phase, double seconds) {
+  Cost& c = cost(file);
+  c.size = file_size(file);
+  c.seconds[phase] = seconds;
+}
+
+void
+Cost_Model::set_tokens(const std::string& file, unsigned tokens) {
+  cost(file).tokens = tokens;
+}
+
+bool
+Cost_Model::has_history(const std::string& file, Phase phase) const {
+  std::map<std::string, Cost>::const_iterator i = costs_.find(file);
+  return i != costs_.end() && i->second.seconds[phase] > 0;
+}
+
+double
+Cost_Model::predict(const std::string& file, Phase phase) const {
+  std::map<std::string, Cost>::const_iterator i = costs_.find(file);
+  if (i != costs_.end() && i->second.seconds[phase] > 0)
+    return i->second.seconds[phase];
+  return file_size(file) * rates_[phase];
+}
+
+void
+Cost_Model::schedule(const std::vector<std::string>& files, Phase phase,
+                     std::vector<unsigned>& order,
+                     std::vector<double>& predicted) const {
+  predicted.resize(files.size());
+  order.resize(files.size());
+  for (unsigned i = 0; i < files.size(); ++i) {
+    predicted[i] = predict(files[i], phase);
+    order[i] = i;
+  }
+  std::stable_sort(order.begin(), order.end(), More_Expensive(predicted));
+}
+
+double
+Cost_Model::makespan(const std::vector<double>& seconds,
+                     const std::vector<unsigned>& order,
+                     unsigned workers) {
+  if (!workers)
+    workers = 1;
+  // finish times, as a min-heap
+  std::vector<double> free_at(workers, 0);
+  for (std::vector<unsigned>::const_iterator i = order.begin(),
+         e = order.end(); i != e; ++i) {
+    std::pop_heap(free_at.begin(), free_at.end(), std::greater<double>());
+    free_at.back() += seconds[*i];
+    std::push_heap(free_at.begin(), free_at.end(), std::greater<double>());
+  }
+  return *std::max_element(free_at.begin(), free_at.end());
+}
+
+} // clang_doc
@@ -0,0 +1,79 @@
+/* -*- Mode: C++ -*-
+//
+// \file: Cost_Model.h
+//
+// \date: 20 Oct 2026 10:11:43 UTC
+//
+// How long each file took to parse, render and write in earlier runs,
+// kept in <object_dir>/clang_doc.costs, one line per file:
+//
+//   size parse render write tokens filename
+//
+// Worker pools hand out the most expensive files first, so one big file
+// doesn't end up running alone at the end.  Files with no history are
+// costed by size, at the average rate of the files that have one.
+//
+*/
+
+#ifndef INCLUDED_COST_MODEL_H
+#define INCLUDED_COST_MODEL_H
+
+#include <map>
+#include <string>
+#include <vector>
+
+namespace clang_doc {
+
+class Cost_Model {
+public:
+  enum Phase {
+    Parse,
+    Render,
+    Write,
+    Num_Phases
+  };
+
+  Cost_Model(void);
+
+  // returns false if filename can't be read, e.g., on the first run
+  bool read(const std::string& filename);
+  bool write(const std::string& filename) const;
+
+  void record(const std::string& file, Phase phase, double seconds);
+  void set_tokens(const std::string& file, unsigned tokens);
+
+  // expected seconds for phase of file
+  double predict(const std::string& file, Phase phase) const;
+  bool has_history(const std::string& file, Phase phase) const;
+
+  // order holds indexes into files, most expensive first, and
+  // predicted the cost of each file
+  void schedule(const std::vector<std::string>& files, Phase phase,
+                std::vector<unsigned>& order,
+                std::vector<double>& predicted) const;
+
+  // wall time for workers to run tasks in order, each worker taking
+  // the next task as soon as it's free
+  static double makespan(const std::vector<double>& seconds,
+                         const std::vector<unsigned>& order,
+                         unsigned workers);
+
+private:
+  struct Cost {
+    unsigned long size;
+    // 0 if never measured
+    double seconds[Num_Phases];
+    unsigned tokens;
+  };
+
+  Cost& cost(const std::string& file);
+  void update_rates(void);
+
+  std::map<std::string, Cost> costs_;
+  // seconds per byte, for files with no history
+  double rates_[Num_Phases];
+};
+
+} // clang_doc
+
+#endif /* INCLUDED_COST_MODEL_H */
@@ -0,0 +1,28 @@
+/* -*- Mode: C++ -*-
+//
+// \file: Definition.h
+//
+// \date: 20 Oct 2026 09:02:18 UTC
+//
+*/
+
+#ifndef INCLUDED_DEFINITION_H
+#define INCLUDED_DEFINITION_H
+
+#include <string>
+
+namespace clang_doc {
+
+struct Definition {
+  std::string key;
+  std::string file;
+  std::string html_path;
+  unsigned line;
+  unsigned column;
+  unsigned offset;
+  bool from_tag_file;
+};
+
+} // clang_doc
+
+#endif /* INCLUDED_DEFINITION_H */
@@ -0,0 +1,363 @@
+/* -*- Mode: C++ -*-
+//
+// \file: Diagnostic_Store.cpp
+//
+// \date: 19 Oct 2026 13:40:19 UTC
+//
+*/
+
+#include "Diagnostic_Store.h"
+#include "Output_Writer.h"
+#include "Utils.h"
+
+#include <iostream>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+namespace clang_doc {
+
+namespace {
+
+// Diagnostic formatting taken from c-index-test.c
+
+void
+append(std::string& out, const char* fmt, ...) {
+  char buf[1024];
+  va_list args;
+  va_start(args, fmt);
+  int n = vsnprintf(buf, sizeof(buf), fmt, args);
+  va_end(args);
+  if (n < 0)
+    return;
+  if ((size_t)n < sizeof(buf)) {
+    out.append(buf, n);
+    return;
+  }
+  std::vector<char> big(n + 1);
+  va_start(args, fmt);
+  vsnprintf(&big[0], big.size(), fmt, args);
+  va_end(args);
+  out.append(&big[0], n);
+}
+
+void
+format_extent(std::string& out, unsigned begin_line, unsigned begin_column,
+              unsigned end_line, unsigned end_column) {
+  append(out, "[%d:%d - %d:%d]", begin_line, begin_column,
+         end_line, end_column);
+}
+
+void
+format_diagnostic(CXDiagnostic diagnostic, std::string& out) {
+  CXFile file;
+  unsigned display_opts = CXDiagnostic_DisplaySourceLocation
+    | CXDiagnostic_DisplayColumn | CXDiagnostic_DisplaySourceRanges
+    | CXDiagnostic_DisplayOption;
+
+  CXString msg = clang_formatDiagnostic(diagnostic, display_opts);
+  append(out, "%s\n", clang_getCString(msg));
+  clang_disposeString(msg);
+
+  clang_getSpellingLocation(clang_getDiagnosticLocation(diagnostic),
+                            &file, 0, 0, 0);
+  if (!file)
+    return;
+
+  unsigned num_fixits = clang_getDiagnosticNumFixIts(diagnostic);
+  append(out, "Number FIX-ITs = %d\n", num_fixits);
+  for (unsigned i = 0; i != num_fixits; ++i) {
+    CXSourceRange range;
+    CXString insertion_text = clang_getDiagnosticFixIt(diagnostic, i, &range);
+    CXSourceLocation start = clang_getRangeStart(range);
+    CXSourceLocation end = clang_getRangeEnd(range);
+    unsigned start_line, start_column, end_line, end_column;
+    CXFile start_file, end_file;
+    clang_getSpellingLocation(start, &start_file, &start_line,
+                              &start_column, 0);
+    clang_getSpellingLocation(end, &end_file, &end_line, &end_column, 0);
+    const char* text = clang_getCString(insertion_text);
+    if (clang_equalLocations(start, end)) {
+      /* Insertion. */
+      if (start_file == file)
+        append(out, "FIX-IT: Insert \"%s\" at %d:%d\n",
+               text, start_line, start_column);
+    } else if (strcmp(text, "") == 0) {
+      /* Removal. */
+      if (start_file == file && end_file == file) {
+        append(out, "FIX-IT: Remove ");
+        format_extent(out, start_line, start_column, end_line, end_column);
+        append(out, "\n");
+      }
+    } else {
+      /* Replacement. */
+      if (start_file == end_file) {
+        append(out, "FIX-IT: Replace ");
+        format_extent(out, start_line, start_column, end_line, end_column);
+        append(out, " with \"%s\"\n", text);
+      }
+      clang_disposeString(insertion_text);
+      break;
+    }
+    clang_disposeString(insertion_text);
+  }
+}
+
+void
+print_set(CXDiagnosticSet set) {
+  unsigned n = clang_getNumDiagnosticsInSet(set);
+  for (unsigned i = 0; i != n; ++i) {
+    CXDiagnostic diag = clang_getDiagnosticInSet(set, i);
+    if (clang_getDiagnosticSeverity(diag) != CXDiagnostic_Ignored) {
+      std::string text;
+      format_diagnostic(diag, text);
+      fputs(text.c_str(), stderr);
+    }
+    CXDiagnosticSet children = clang_getChildDiagnostics(diag);
+    if (children)
+      print_set(children);
+  }
+}
+
+const char*
+severity_name(CXDiagnosticSeverity severity) {
+  switch (severity) {
+  case (CXDiagnostic_Ignored): return "ignored";
+  case (CXDiagnostic_Note): return "note";
+  case (CXDiagnostic_Warning): return "warning";
+  case (CXDiagnostic_Error): return "error";
+  case (CXDiagnostic_Fatal): return "fatal";
+  }
+  return "unknown";
+}
+
+// length prefixed fields for serialize() and merge()
+void
+put_field(std::string& out, const std::string& field) {
+  char len[32];
+  snprintf(len, sizeof(len), "%lu:", (unsigned long)field.length());
+  out += len;
+  out += field;
+}
+
+void
+put_field(std::string& out, unsigned n) {
+  char buf[32];
+  snprintf(buf, sizeof(buf), "%u", n);
+  put_field(out, std::string(buf));
+}
+
+bool
+get_field(const std::string& data, size_t& pos, std::string& field) {
+  size_t colon = data.find(':', pos);
+  if (colon == std::string::npos)
+    return false;
+  unsigned long len = strtoul(data.c_str() + pos, 0, 10);
+  if (len > data.length() - colon - 1)
+    return false;
+  field.assign(data, colon + 1, len);
+  pos = colon + 1 + len;
+  return true;
+}
+
+bool
+get_field(const std::string& data, size_t& pos, unsigned& n) {
+  std::string field;
+  if (!get_field(data, pos, field))
+    return false;
+  n = strtoul(field.c_str(), 0, 10);
+  return true;
+}
+
+std::string
+entry_key(const std::string& file, unsigned line, unsigned column,
+          const std::string& message) {
+  char pos[32];
+  snprintf(pos, sizeof(pos), ":%u:%u:", line, column);
+  return file + pos + message;
+}
+
+} // anonymous namespace
+
+Diagnostic_Store::Diagnostic_Store(void)
+  : min_severity_(CXDiagnostic_Note),
+    total_(0),
+    suppressed_(0) {}
+
+void
+Diagnostic_Store::print_all(CXTranslationUnit tu) {
+  CXDiagnosticSet set = clang_getDiagnosticSetFromTU(tu);
+  print_set(set);
+  clang_disposeDiagnosticSet(set);
+}
+
+void
+Diagnostic_Store::collect(CXTranslationUnit tu, const std::string& source_filename) {
+  CXDiagnosticSet set = clang_getDiagnosticSetFromTU(tu);
+  collect_set(set, source_filename);
+  clang_disposeDiagnosticSet(set);
+}
+
+void
+Diagnostic_Store::collect_set(CXDiagnosticSet set, const std::string& source_filename) {
+  unsigned n = clang_getNumDiagnosticsInSet(set);
+  for (unsigned i = 0; i != n; ++i) {
+    CXDiagnostic diag = clang_getDiagnosticInSet(set, i);
+    CXDiagnosticSet children = clang_getChildDiagnostics(diag);
+
+    CXDiagnosticSeverity severity = clang_getDiagnosticSeverity(diag);
+    if (severity == CXDiagnostic_Ignored || severity < min_severity_) {
+      ++suppressed_;
+    }
+    else {
+      ++total_;
+
+      CXFile file;
+      unsigned line;
+      unsigned column;
+      clang_getSpellingLocation(clang_getDiagnosticLocation(diag),
+                                &file, &line, &column, 0);
+      CXString cxfn = clang_getFileName(file);
+      CXString cxmsg = clang_getDiagnosticSpelling(diag);
+      const char* fn = clang_getCString(cxfn);
+
+      std::string key = entry_key(fn ? fn : "", line, column,
+                                  clang_getCString(cxmsg));
+
+      std::map<std::string, unsigned>::iterator s = seen_.find(key);
+      if (s != seen_.end()) {
+        ++entries_[s->second].count;
+      }
+      else {
+        Entry entry;
+        entry.file = fn ? fn : "";
+        entry.line = line;
+        entry.column = column;
+        entry.severity = severity;
+        entry.message = clang_getCString(cxmsg);
+        entry.first_tu = source_filename;
+        entry.count = 1;
+        format_diagnostic(diag, entry.text);
+        add(entry, key);
+      }
+      clang_disposeString(cxmsg);
+      clang_disposeString(cxfn);
+    }
+
+    if (children)
+      collect_set(children, source_filename);
+  }
+}
+
+void
+Diagnostic_Store::add(const Entry& entry, const std::string& key) {
+  seen_.insert(std::pair<std::string, unsigned>(key, entries_.size()));
+  entries_.push_back(entry);
+}
+
+void
+Diagnostic_Store::serialize(std::string& out) const {
+  put_field(out, total_);
+  put_field(out, suppressed_);
+  put_field(out, entries_.size());
+  for (std::vector<Entry>::const_iterator i = entries_.begin(),
+         e = entries_.end(); i != e; ++i) {
+    put_field(out, (*i).file);
+    put_field(out, (*i).line);
+    put_field(out, (*i).column);
+    put_field(out, (*i).severity);
+    put_field(out, (*i).message);
+    put_field(out, (*i).text);
+    put_field(out, (*i).first_tu);
+    put_field(out, (*i).count);
+  }
+}
+
+bool
+Diagnostic_Store::merge(const std::string& data) {
+  size_t pos = 0;
+  unsigned total;
+  unsigned suppressed;
+  unsigned num;
+  if (!get_field(data, pos, total) || !get_field(data, pos, suppressed) ||
+      !get_field(data, pos, num))
+    return false;
+
+  for (unsigned n = 0; n < num; ++n) {
+    Entry entry;
+    unsigned severity;
+    if (!get_field(data, pos, entry.file) ||
+        !get_field(data, pos, entry.line) ||
+        !get_field(data, pos, entry.column) ||
+        !get_field(data, pos, severity) ||
+        !get_field(data, pos, entry.message) ||
+        !get_field(data, pos, entry.text) ||
+        !get_field(data, pos, entry.first_tu) ||
+        !get_field(data, pos, entry.count))
+      return false;
+    entry.severity = static_cast<CXDiagnosticSeverity>(severity);
+
+    std::string key = entry_key(entry.file, entry.line, entry.column, entry.message);
+    std::map<std::string, unsigned>::iterator s = seen_.find(key);
+    if (s != seen_.end())
+      entries_[s->second].count += entry.count;
+    else
+      add(entry, key);
+  }
+  total_ += total;
+  suppressed_ += suppressed;
+  return true;
+}
+
+void
+Diagnostic_Store::print(std::ostream& os) const {
+  unsigned counts[CXDiagnostic_Fatal + 1] = {0};
+  for (std::vector<Entry>::const_iterator i = entries_.begin(),
+         e = entries_.end(); i != e; ++i) {
+    os << (*i).text.c_str();
+    if ((*i).count > 1)
+      os << "  (reported " << (*i).count << " times)\n";
+    ++counts[(*i).severity];
+  }
+
+  os << "\ndiagnostics: " << entries_.size() << " unique ("
+     << counts[CXDiagnostic_Fatal] + counts[CXDiagnostic_Error] << " errors, "
+     << counts[CXDiagnostic_Warning] << " warnings, "
+     << counts[CXDiagnostic_Note] << " notes), "
+     << total_ << " reported, "
+     << total_ - entries_.size() << " duplicates, "
+     << suppressed_ << " suppressed\n";
+}
+
+bool
+Diagnostic_Store::write(const std::string& filename) const {
+  char* buf = 0;
+  size_t len = 0;
+  FILE* f = open_memstream(&buf, &len);
+  if (!f) {
+    std::cerr << "error creating diagnostics file: " << filename.c_str() << "\n";
+    return false;
+  }
+
+  fprintf(f, "[\n");
+  for (std::vector<Entry>::const_iterator i = entries_.begin(),
+         e = entries_.end(); i != e; ++i) {
+    fprintf(f, "  {\"file\": ");
+    write_json_string(f, (*i).file);
+    fprintf(f, ", \"line\": %u, \"column\": %u, \"severity\": \"%s\", \"count\": %u",
+            (*i).line, (*i).column, severity_name((*i).severity), (*i).count);
+    fprintf(f, ", \"message\": ");
+    write_json_string(f, (*i).message);
+    fprintf(f, ", \"first_tu\": ");
+    write_json_string(f, (*i).first_tu);
+    fprintf(f, "}%s\n", i + 1 == e ? "" : ",");
+  }
+  fprintf(f, "]\n");
+  fclose(f);
+  bool ok = Output_Writer().write_if_changed(filename, buf, len);
+  free(buf);
+  return ok;
+}
+
+} // clang_doc
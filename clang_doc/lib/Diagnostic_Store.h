@@ -0,0 +1,77 @@
+/* -*- Mode: C++ -*-
+//
+// \file: Diagnostic_Store.h
+//
+// \date: 19 Oct 2026 13:40:05 UTC
+//
+// Run-wide collection of the diagnostics reported by every TU.  A header
+// warning is reported by each TU that includes it, so diagnostics are
+// deduplicated by location and message, and only the first occurrence is
+// ever formatted.
+//
+*/
+
+#ifndef INCLUDED_DIAGNOSTIC_STORE_H
+#define INCLUDED_DIAGNOSTIC_STORE_H
+
+#include "clang-c/Index.h"
+
+#include <map>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace clang_doc {
+
+class Diagnostic_Store {
+public:
+  Diagnostic_Store(void);
+
+  // diagnostics below min_severity are dropped without being formatted
+  void set_min_severity(CXDiagnosticSeverity severity) {min_severity_ = severity;}
+  CXDiagnosticSeverity min_severity(void) const {return min_severity_;}
+
+  void collect(CXTranslationUnit tu, const std::string& source_filename);
+
+  // print each unique diagnostic once, followed by a summary with counts
+  void print(std::ostream& os) const;
+  bool write(const std::string& filename) const;
+
+  // pass a store between processes: serialize() in one, merge() the
+  // result into another, deduplicating as collect() does
+  void serialize(std::string& out) const;
+  bool merge(const std::string& data);
+
+  // format and print every diagnostic in tu to stderr without collecting
+  static void print_all(CXTranslationUnit tu);
+
+  unsigned total(void) const {return total_;}
+  unsigned unique(void) const {return entries_.size();}
+
+private:
+  struct Entry {
+    std::string file;
+    unsigned line;
+    unsigned column;
+    CXDiagnosticSeverity severity;
+    std::string message;
+    std::string text;
+    std::string first_tu;
+    unsigned count;
+  };
+
+  void collect_set(CXDiagnosticSet set, const std::string& source_filename);
+  void add(const Entry& entry, const std::string& key);
+
+  CXDiagnosticSeverity min_severity_;
+  unsigned total_;
+  unsigned suppressed_;
+
+  // key is "file:line:column:message"; entries_ keeps first seen order
+  std::map<std::string, unsigned> seen_;
+  std::vector<Entry> entries_;
+};
+
+} // clang_doc
+
+#endif /* INCLUDED_DIAGNOSTIC_STORE_H */
@@ -0,0 +1,233 @@
+/* -*- Mode: C++ -*-
+//
+// \file: Frozen_Table.cpp
+//
+// \date: 20 Oct 2026 09:05:26 UTC
+//
+*/
+
+#include "Frozen_Table.h"
+#include "Utils.h"
+
+#include <algorithm>
+#include <map>
+#include <string.h>
+
+namespace clang_doc {
+
+namespace {
+
+// give up on a bucket after this many displacements; only keys whose
+// 64 bit hashes collide outright should ever get here
+const int max_displacement = 1 << 24;
+
+unsigned long long
+mix(unsigned long long h) {
+  h ^= h >> 30;
+  h *= 0xbf58476d1ce4e5b9ULL;
+  h ^= h >> 27;
+  h *= 0x94d049bb133111ebULL;
+  h ^= h >> 31;
+  return h;
+}
+
+struct Larger_Bucket {
+  explicit Larger_Bucket(const std::vector<std::vector<size_t> >& buckets)
+    : buckets_(buckets) {}
+  bool operator()(size_t a, size_t b) const {
+    return buckets_[a].size() > buckets_[b].size();
+  }
+  const std::vector<std::vector<size_t> >& buckets_;
+};
+
+struct Key_Less {
+  explicit Key_Less(const std::vector<const Definition*>& defs)
+    : defs_(defs) {}
+  bool operator()(size_t a, size_t b) const {
+    return defs_[a]->key < defs_[b]->key;
+  }
+  const std::vector<const Definition*>& defs_;
+};
+
+size_t
+append(std::vector<char>& arena, const std::string& s) {
+  size_t offset = arena.size();
+  arena.insert(arena.end(), s.begin(), s.end());
+  arena.push_back(0);
+  return offset;
+}
+
+size_t
+intern(std::vector<char>& arena, std::map<std::string, size_t>& pool,
+       const std::string& s) {
+  std::map<std::string, size_t>::iterator i = pool.find(s);
+  if (i != pool.end())
+    return i->second;
+  size_t offset = append(arena, s);
+  pool.insert(std::pair<std::string, size_t>(s, offset));
+  return offset;
+}
+
+} // anonymous namespace
+
+Frozen_Table::Frozen_Table(void) {}
+
+std::string
+Frozen_Table::href(const Definition& def, const std::string& prefix,
+                   Layout page_layout, Layout def_layout) {
+  if (def.file.empty())
+    return std::string();
+  std::string href = make_filename(def.file, def.html_path, prefix, ".html",
+                                   !def.html_path.empty(), def_layout);
+  if (href[0] != '/')
+    href.insert(0, root_prefix(page_layout));
+  return href;
+}
+
+size_t
+Frozen_Table::slot(unsigned long long hash, int displacement) const {
+  return mix(hash + displacement * 0x9e3779b97f4a7c15ULL) % entries_.size();
+}
+
+int
+Frozen_Table::compare(const Entry& e, const std::string& key) const {
+  size_t n = e.key_length < key.length() ? e.key_length : key.length();
+  int cmp = memcmp(string(e.key_offset), key.data(), n);
+  if (cmp == 0)
+    cmp = e.key_length < key.length() ? -1 : (e.key_length > key.length() ? 1 : 0);
+  return cmp;
+}
+
+bool
+Frozen_Table::build(const std::vector<const Definition*>& defs,
+                    const std::string& prefix,
+                    Layout page_layout,
+                    Layout def_layout) {
+  entries_.clear();
+  displacements_.clear();
+  arena_.clear();
+  size_t n = defs.size();
+  if (n == 0)
+    return true;
+
+  // the strings go in first, so entries only need their offsets
+  std::vector<Entry> entries(n);
+  std::map<std::string, size_t> files;
+  std::map<std::string, size_t> hrefs;
+  for (size_t i = 0; i < n; ++i) {
+    const Definition& def = *defs[i];
+    Entry& e = entries[i];
+    e.hash = hash_bytes(def.key.data(), def.key.length());
+    e.key_offset = append(arena_, def.key);
+    e.key_length = def.key.length();
+    e.file_offset = intern(arena_, files, def.file);
+    e.href_offset = intern(arena_, hrefs, href(def, prefix, page_layout, def_layout));
+    e.line = def.line;
+    if (arena_.size() > 0xffffffffULL) {
+      arena_.clear();
+      return false;
+    }
+  }
+
+  std::vector<std::vector<size_t> > buckets(n);
+  for (size_t i = 0; i < n; ++i)
+    buckets[(entries[i].hash >> 32) % n].push_back(i);
+
+  std::vector<size_t> order(n);
+  for (size_t b = 0; b < n; ++b)
+    order[b] = b;
+  std::stable_sort(order.begin(), order.end(), Larger_Bucket(buckets));
+
+  entries_.resize(n);
+  displacements_.assign(n, 0);
+  std::vector<bool> used(n, false);
+  std::vector<size_t> slots;
+
+  // place the crowded buckets first, while there's room to find a
+  // displacement that puts all their keys in free slots
+  size_t b = 0;
+  for (; b < n && buckets[order[b]].size() > 1; ++b) {
+    const std::vector<size_t>& bucket = buckets[order[b]];
+    int d = 1;
+    for (; d < max_displacement; ++d) {
+      slots.clear();
+      size_t k = 0;
+      for (; k < bucket.size(); ++k) {
+        size_t s = slot(entries[bucket[k]].hash, d);
+        if (used[s] || std::find(slots.begin(), slots.end(), s) != slots.end())
+          break;
+        slots.push_back(s);
+      }
+      if (k == bucket.size())
+        break;
+    }
+    if (d == max_displacement) {
+      // search the entries by key instead
+      displacements_.clear();
+      for (size_t i = 0; i < n; ++i)
+        order[i] = i;
+      std::sort(order.begin(), order.end(), Key_Less(defs));
+      for (size_t i = 0; i < n; ++i)
+        entries_[i] = entries[order[i]];
+      return false;
+    }
+    displacements_[order[b]] = d;
+    for (size_t k = 0; k < bucket.size(); ++k) {
+      used[slots[k]] = true;
+      entries_[slots[k]] = entries[bucket[k]];
+    }
+  }
+
+  // the rest hold one key each, which can go straight into any free slot
+  size_t free_slot = 0;
+  for (; b < n && !buckets[order[b]].empty(); ++b) {
+    while (used[free_slot])
+      ++free_slot;
+    used[free_slot] = true;
+    entries_[free_slot] = entries[buckets[order[b]][0]];
+    displacements_[order[b]] = -static_cast<int>(free_slot) - 1;
+  }
+  return true;
+}
+
+bool
+Frozen_Table::find(const std::string& key, Match& match) const {
+  if (entries_.empty())
+    return false;
+
+  const Entry* e = 0;
+  if (!displacements_.empty()) {
+    unsigned long long h = hash_bytes(key.data(), key.length());
+    int d = displacements_[(h >> 32) % displacements_.size()];
+    if (d == 0)
+      return false;
+    e = &entries_[d < 0 ? -(d + 1) : slot(h, d)];
+    if (e->hash != h || compare(*e, key) != 0)
+      return false;
+  }
+  else {
+    size_t lo = 0;
+    size_t hi = entries_.size();
+    while (lo < hi) {
+      size_t mid = lo + (hi - lo) / 2;
+      int cmp = compare(entries_[mid], key);
+      if (cmp == 0) {
+        e = &entries_[mid];
+        break;
+      }
+      if (cmp < 0)
+        lo = mid + 1;
+      else
+        hi = mid;
+    }
+    if (!e)
+      return false;
+  }
+
+  match.file = string(e->file_offset);
+  match.href = string(e->href_offset);
+  match.line = e->line;
+  return true;
+}
+
+} // clang_doc
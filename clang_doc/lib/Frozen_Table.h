@@ -0,0 +1,88 @@
+/* -*- Mode: C++ -*-
+//
+// \file: Frozen_Table.h
+//
+// \date: 20 Oct 2026 09:04:51 UTC
+//
+// A read-only table of definitions, built once the symbol table is
+// complete.  Keys are placed with a minimal perfect hash (hash and
+// displace): one hash picks a bucket, and the bucket's displacement
+// picks the key's slot, so a lookup touches one bucket, one slot and
+// one string compare.  Each entry also holds the href that links to
+// the definition point at, so pages don't rebuild it for every use.
+//
+// Entries hold offsets into one string arena, where keys, files and
+// hrefs are stored NUL terminated, each file and href only once.
+//
+*/
+
+#ifndef INCLUDED_FROZEN_TABLE_H
+#define INCLUDED_FROZEN_TABLE_H
+
+#include "Definition.h"
+#include "Utils.h"
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+namespace clang_doc {
+
+class Frozen_Table {
+public:
+  // a definition found in a table; the strings live as long as the table
+  struct Match {
+    const char* file;
+    // the page to link to (empty for the current page); the line
+    // anchor is line
+    const char* href;
+    unsigned line;
+  };
+
+  Frozen_Table(void);
+
+  // replaces the table.  keys must be unique.  hrefs are made relative
+  // to prefix, as make_filename() does for the page's own links, for
+  // pages arranged in page_layout linking to pages in def_layout.
+  // returns false if no perfect hash was found, in which case lookups
+  // fall back to a binary search, or, leaving the table empty, if the
+  // strings don't fit in 4GB.
+  bool build(const std::vector<const Definition*>& defs,
+             const std::string& prefix,
+             Layout page_layout,
+             Layout def_layout);
+
+  bool find(const std::string& key, Match& match) const;
+
+  size_t size(void) const {return entries_.size();}
+  bool empty(void) const {return entries_.empty();}
+
+  static std::string href(const Definition& def, const std::string& prefix,
+                          Layout page_layout, Layout def_layout);
+
+private:
+  struct Entry {
+    unsigned long long hash;
+    uint32_t key_offset;
+    uint32_t key_length;
+    uint32_t file_offset;
+    uint32_t href_offset;
+    unsigned line;
+  };
+
+  size_t slot(unsigned long long hash, int displacement) const;
+  const char* string(uint32_t offset) const {return &arena_[offset];}
+  int compare(const Entry& e, const std::string& key) const;
+
+  // in slot order, or sorted by key without a perfect hash
+  std::vector<Entry> entries_;
+  // per bucket: 0 if empty, -(slot + 1) for a bucket holding a single
+  // key, otherwise the displacement used for all its keys.  empty
+  // without a perfect hash.
+  std::vector<int> displacements_;
+  std::vector<char> arena_;
+};
+
+} // clang_doc
+
+#endif /* INCLUDED_FROZEN_TABLE_H */
@@ -0,0 +1,85 @@
+/* -*- Mode: C++ -*-
+//
+// \file: Gzip_Stream.cpp
+//
+// \date: 19 Oct 2026 19:31:44 UTC
+//
+*/
+
+#include "Gzip_Stream.h"
+
+#include <string.h>
+
+namespace clang_doc {
+
+Gzip_Stream::Gzip_Stream(int level)
+  : initialized_(false),
+    out_(0) {
+  memset(&z_, 0, sizeof(z_));
+  // 15 + 16 asks zlib for a gzip header and trailer
+  initialized_ = deflateInit2(&z_, level, Z_DEFLATED, 15 + 16, 8,
+                              Z_DEFAULT_STRATEGY) == Z_OK;
+}
+
+Gzip_Stream::~Gzip_Stream(void) {
+  if (initialized_)
+    deflateEnd(&z_);
+}
+
+FILE*
+Gzip_Stream::open(FILE* out) {
+  if (!initialized_ || out_ || !out)
+    return 0;
+
+  cookie_io_functions_t io;
+  io.read = 0;
+  io.write = write_c;
+  io.seek = 0;
+  io.close = close_c;
+
+  FILE* f = fopencookie(this, "w", io);
+  if (f)
+    out_ = out;
+  return f;
+}
+
+bool
+Gzip_Stream::deflate_to_out(int flush) {
+  int ret;
+  do {
+    z_.next_out = buf_;
+    z_.avail_out = sizeof(buf_);
+    ret = deflate(&z_, flush);
+    if (ret == Z_STREAM_ERROR)
+      return false;
+    size_t n = sizeof(buf_) - z_.avail_out;
+    if (n && fwrite(buf_, 1, n, out_) != n)
+      return false;
+  } while (z_.avail_out == 0 || (flush == Z_FINISH && ret != Z_STREAM_END));
+  return true;
+}
+
+ssize_t
+Gzip_Stream::write_c(void* cookie, const char* buf, size_t size) {
+  Gzip_Stream* gz = static_cast<Gzip_Stream*>(cookie);
+  gz->z_.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(buf));
+  gz->z_.avail_in = size;
+  if (!gz->deflate_to_out(Z_NO_FLUSH))
+    return 0;
+  return size;
+}
+
+int
+Gzip_Stream::close_c(void* cookie) {
+  Gzip_Stream* gz = static_cast<Gzip_Stream*>(cookie);
+  gz->z_.next_in = 0;
+  gz->z_.avail_in = 0;
+  bool ok = gz->deflate_to_out(Z_FINISH);
+  if (fclose(gz->out_) != 0)
+    ok = false;
+  gz->out_ = 0;
+  deflateReset(&gz->z_);
+  return ok ? 0 : EOF;
+}
+
+} // clang_doc
@@ -0,0 +1,50 @@
+/* -*- Mode: C++ -*-
+//
+// \file: Gzip_Stream.h
+//
+// \date: 19 Oct 2026 19:31:27 UTC
+//
+// Gzip compression of pages as they are written.  open() wraps an
+// output FILE* in a FILE* that compresses everything written to it, so
+// the rest of clang_doc can keep using stdio.  The deflate state is
+// reset and reused for every file rather than set up each time.
+//
+*/
+
+#ifndef INCLUDED_GZIP_STREAM_H
+#define INCLUDED_GZIP_STREAM_H
+
+#include <stdio.h>
+#include <sys/types.h>
+#include <zlib.h>
+
+namespace clang_doc {
+
+class Gzip_Stream {
+public:
+  explicit Gzip_Stream(int level = Z_DEFAULT_COMPRESSION);
+  ~Gzip_Stream(void);
+
+  // returns a stream that compresses into out, or 0 on error.  fclose()
+  // on the returned stream finishes the gzip member and closes out.  Only
+  // one stream can be open at a time.
+  FILE* open(FILE* out);
+
+private:
+  Gzip_Stream(const Gzip_Stream&);
+  Gzip_Stream& operator=(const Gzip_Stream&);
+
+  static ssize_t write_c(void* cookie, const char* buf, size_t size);
+  static int close_c(void* cookie);
+
+  bool deflate_to_out(int flush);
+
+  z_stream z_;
+  bool initialized_;
+  FILE* out_;
+  unsigned char buf_[64 * 1024];
+};
+
+} // clang_doc
+
+#endif /* INCLUDED_GZIP_STREAM_H */
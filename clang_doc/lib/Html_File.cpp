@@ -0,0 +1,734 @@
+/* -*- Mode: C++ -*-
+//
+// \file: Html_File.cpp
+//
+// \author: Don Allon Hinton <don.hinton@gmx.com>
+// \date: 13 Aug 2012 15:11:35 UTC
+//
+*/
+
+#include "Html_File.h"
+#include "Async_Writer.h"
+#include "Gzip_Stream.h"
+#include "Html_Writer.h"
+#include "Mapped_File.h"
+#include "Output_Writer.h"
+#include "Render_Cache.h"
+#include "TU_File.h"
+#include "Token_Stream_Writer.h"
+#include "Utils.h"
+#include "Xref_Index.h"
+
+#include <iostream>
+#include <sys/stat.h>
+#include <libgen.h>
+#include <sys/param.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+// These are here for testing only, please don't remove
+#ifdef __cplusplus
+extern "C" {
+#endif
+#ifdef __cplusplus
+}
+#endif
+
+namespace clang_doc {
+
+Html_File::Html_File(int argc,
+                     char* argv[],
+                     CXIndex idx,
+                     const std::vector<std::string>& includes,
+                     const std::set<std::string>& files,
+                     const Symbol_Table& symbols,
+                     const std::string& source_filename,
+                     const std::string& object_dir,
+                     const std::string& html_dir,
+                     const std::string& prefix)
+  : argc_(argc),
+    argv_(argv),
+    idx_(idx),
+    tu_file_(0),
+    xref_(0),
+    diags_(0),
+    gzip_(0),
+    output_(0),
+    includes_ (includes),
+    files_(files),
+    symbols_(symbols),
+    source_filename_(source_filename),
+    format_(Format_Html),
+    layout_(Layout_Flat),
+    reparse_(false),
+    num_tokens_(0),
+    unsaved_(0),
+    num_unsaved_(0),
+    source_data_(0),
+    source_size_(0),
+    preprocessor_(false),
+    include_(false) {
+  object_dir_ = strip_final_seps(object_dir);
+  html_dir_ = strip_final_seps(html_dir);
+  prefix_ = strip_final_seps(prefix);
+  html_filename_ = make_filename(source_filename_, html_dir_, prefix_, ".html");
+  cache_filename_ = make_filename(source_filename_, object_dir_, prefix_, ".rc");
+}
+
+void
+Html_File::set_layout(Layout layout) {
+  layout_ = layout;
+  html_filename_ = make_filename(source_filename_, html_dir_, prefix_, ".html",
+                                 true, layout_);
+  cache_filename_ = make_filename(source_filename_, object_dir_, prefix_, ".rc",
+                                  true, layout_);
+}
+
+Html_File::~Html_File(void) {
+  delete(tu_file_);
+}
+
+void
+Html_File::write_header(FILE* f) {
+  fprintf (f, "<html><head>\n");
+  fprintf (f, "<meta http-equiv=\"Content-Type\" content=\"text/html;charset=iso-8859-1\"/>");
+  fprintf (f, "<meta name=\"keywords\" content=\"clang,clang_doc, C, C++\"/>");
+  fprintf (f, "<meta name=\"description\" content=\"C++ source code API documentation for clang.\"/>");
+  fprintf (f, "<title>clang: %s Source File</title>", source_filename_.c_str());
+  const char* root = root_prefix(layout_);
+  fprintf (f, "<link href=\"%sdoxygen.css\" rel=\"stylesheet\" type=\"text/css\"/>", root);
+  fprintf (f, "</head><body>");
+  fprintf (f, "<p class=\"title\">clang Code Documentation</p>");
+  fprintf (f, "<div class=\"navigation\" id=\"top\">");
+  fprintf (f, "  <div class=\"tabs\">");
+  fprintf (f, "    <ul>");
+  fprintf (f, "      <li><a href=\"%sindex.html\"><span>Main&nbsp;Page</span></a></li>", root);
+  if (xref_) {
+    std::string refs = root + make_filename(source_filename_, html_dir_, prefix_,
+                                            ".refs.html", false, layout_);
+    fprintf (f, "      <li><a href=\"%s\"><span>References</span></a></li>", refs.c_str());
+  }
+  fprintf (f, "    </ul>");
+  fprintf (f, "  </div>");
+  fprintf (f, "</div>");
+  fprintf (f, "<div class=\"contents\">");
+  fprintf (f, "<h1>%s</h1>", source_filename_.c_str());
+  fprintf (f, "<div class=\"fragment\">");
+}
+
+namespace {
+std::string
+munge_fullyscopedname(const std::string& str) {
+  // strip out the "class@" instances and convert "_Bool@" to "bool@"
+  std::string result = str;
+  size_t pos = result.find("class@");
+  while (pos != std::string::npos) {
+    result.replace (pos, 6,"");
+    pos = result.find("class@");
+  }
+
+  pos = result.find("enum@");
+  while (pos != std::string::npos) {
+    result.replace (pos, 5,"");
+    pos = result.find("enum@");
+  }
+
+  pos = result.find("@_Bool");
+  while (pos != std::string::npos) {
+    result.replace (pos, 6,"@bool");
+    pos = result.find("@_Bool");
+  }
+  return result;
+}
+
+// bytes of source tokenized at a time by write_tokens()
+const unsigned token_window_bytes = 64 * 1024;
+
+} // anonymous namespace
+
+void
+Html_File::add_xref(const std::string& key, unsigned line) {
+  if (xref_ && !key.empty())
+    xref_->add(key, source_filename_, line);
+}
+
+void
+Html_File::write_token(Render_Cache& w,
+                       CXFile file,
+                       CXToken tok,
+                       const char* str,
+                       size_t len,
+                       unsigned line,
+                       unsigned column)
+{
+  // str is a view into the source, and is not NUL terminated
+
+  CXSourceLocation tloc = clang_getTokenLocation(tu_file_->tu(), tok);
+  CXCursor c = clang_getCursor(tu_file_->tu(), tloc);
+
+  if (cur_line_ <= line) cur_column_ = 1;
+
+  for (; cur_line_ <= line; ++cur_line_)
+    w.line(cur_line_);
+
+  if (cur_column_ <= column) {
+    w.spaces(column + 1 - cur_column_);
+    cur_column_ = column + 1;
+  }
+
+  switch (clang_getTokenKind(tok)) {
+  case (CXToken_Punctuation):
+    if (len && str[0] == '#')
+      preprocessor_ = true;
+    w.punctuation(str, len);
+    break;
+  case (CXToken_Keyword):
+    w.keyword(str, len);
+    break;
+  case (CXToken_Comment):
+    w.comment(str, len);
+    // columns have always been counted in escaped characters for comments
+    cur_column_ += Html_Writer::escaped_length(str, len) - len;
+    break;
+  case (CXToken_Literal): {
+    //include = false; // disable include links for now
+    if (include_) {
+      include_ = false;
+      // found an include file
+      std::string t;
+      for (const char* p = str; p != str + len; ++p) {
+        if (*p != '"')
+          t += *p;
+      }
+
+      // first, use this file's path, then all the include paths.
+      // dirname() may write to its argument, so it gets a copy.
+      std::vector<char> source(source_filename_.begin(), source_filename_.end());
+      source.push_back('\0');
+      std::string includefile;
+      bool found_include = find_include(dirname(&source[0]), t, includefile);
+      for (std::vector<std::string>::const_iterator i = includes_.begin(),
+             e = includes_.end(); i != e && !found_include; ++i)
+        found_include = find_include(*i, t, includefile);
+      if (found_include) {
+        // resolved against files_ and the symbol table in replay()
+        w.include(includefile, str, len);
+        break;
+      }
+    }
+    // not an include or include not found
+    w.literal(str, len);
+    break;
+  }
+  case (CXToken_Identifier): {
+    if (preprocessor_) {
+      preprocessor_ = false;
+      if (len == 7 && strncmp(str, "include", 7) == 0)
+        include_ = true;
+      w.identifier(str, len);
+      break;
+    }
+
+    if (clang_isUnexposed(c.kind)) {
+      w.identifier(str, len);
+      w.debug(__LINE__, "", str, len, c.kind);
+      break;
+    }
+
+    // Calling clang_getCursorDefinition() does not work properly
+    // for template classes, i.e., it will find the method
+    // declaration, not the definition, if they differ.  However,
+    // once you have the declaration's location, you can use it
+    // get that cursor, and find the definition that way.
+    CXSourceLocation decloc =
+      clang_getCursorLocation(clang_getCursorDefinition(c));
+    CXCursor cref =
+      clang_getCursorDefinition(clang_getCursor(tu_file_->tu(),
+                                                decloc));
+
+    if (clang_isUnexposed(cref.kind)) {
+      w.identifier(str, len);
+      w.debug(__LINE__, "(ref) ", str, len, cref.kind);
+      break;
+    }
+
+    std::string rfile;
+    unsigned refl = line;
+    bool found = false;
+
+    if (!clang_Cursor_isNull(cref) && cref.kind != CXCursor_Namespace) {
+      CXSourceLocation refloc = clang_getCursorLocation(cref);
+      if (!clang_equalLocations(tloc, refloc)) {
+        CXFile cxfile;
+        unsigned col;
+        unsigned off;
+        clang_getExpansionLocation(refloc, &cxfile, &refl, &col, &off);
+        if (cxfile == file) {
+          found = true;
+          w.debug(__LINE__, "(ref) ", str, len, cref.kind);
+        }
+        else {
+          CXString cxfn = clang_getFileName(cxfile);
+          const char* fn = clang_getCString(cxfn);
+          if (fn) {
+            if (files_.find(fn) != files_.end()) {
+              rfile = fn;
+              found = true;
+              w.debug(__LINE__, "(ref) ", str, len, cref.kind);
+            }
+          }
+          clang_disposeString(cxfn);
+        }
+      }
+    }
+    else if (!clang_isDeclaration(c.kind) && c.kind != CXCursor_Namespace) {
+      CXCursor ref = clang_getCursorReferenced(c);
+      if (ref.kind != CXCursor_Namespace) {
+        std::string fsn = munge_fullyscopedname(fullyScopedName(ref));
+        if (fsn.empty()) {
+            w.debug(__LINE__, "(fsn empty) ", str, len, c.kind);
+        } else {
+          // resolved against the symbol table in replay()
+          w.symbol(fsn, line, c.kind, str, len);
+          break;
+        }
+      }
+    }
+
+    // only references to definitions with external linkage are indexed,
+    // which replay() checks against the symbol table
+    if (found)
+      w.xref(fullyScopedName(cref), line);
+
+    // since we are linking to lines, no need to link to same line
+    if (found && (!rfile.empty() || refl != line)) {
+      if (!rfile.empty())
+        rfile = root_prefix(layout_) + make_filename(rfile, "", prefix_, ".html",
+                                                     false, layout_);
+      w.link(rfile.c_str(), refl, str, len);
+      break;
+    }
+    w.identifier(str, len);
+    break;
+  }
+  }
+  cur_column_ += len;
+}
+
+// FIXME:  change this to just printing comments, and call write_token()
+//         directly from write_html() for non-comments.
+bool
+Html_File::find_include(const std::string& dir, const std::string& name,
+                        std::string& includefile) {
+  // an unsaved buffer may not exist on disk, nor its directory
+  std::string unresolved = dir + "/" + name;
+  if (find_unsaved(unsaved_, num_unsaved_, unresolved)) {
+    includefile = unresolved;
+    return true;
+  }
+
+  char path[PATH_MAX];
+  if (!realpath(dir.c_str(), path))
+    return false;
+  includefile = path;
+  includefile += "/" + name;
+  if (find_unsaved(unsaved_, num_unsaved_, includefile))
+    return true;
+  struct stat st;
+  return stat(includefile.c_str(), &st) == 0;
+}
+
+void
+Html_File::write_comment_split(Render_Cache& w, CXFile file, CXToken tok) {
+  unsigned line;
+  unsigned column;
+  unsigned offset;
+
+  CXSourceLocation loc = clang_getTokenLocation(tu_file_->tu(), tok);
+  clang_getExpansionLocation(loc, &file, &line, &column, &offset);
+
+  CXTokenKind kind = clang_getTokenKind(tok);
+
+  // take the token text straight from the mapped source when we can, and
+  // only fall back to clang_getTokenSpelling() if we can't.
+  const char* str = 0;
+  size_t len = 0;
+  if (source_data_) {
+    CXSourceRange extent = clang_getTokenExtent(tu_file_->tu(), tok);
+    CXFile end_file;
+    unsigned end_offset;
+    clang_getExpansionLocation(clang_getRangeEnd(extent), &end_file, 0, 0,
+                               &end_offset);
+    if (end_file == file && offset <= end_offset && end_offset <= source_size_) {
+      str = source_data_ + offset;
+      len = end_offset - offset;
+    }
+  }
+  if (!str) {
+    CXString s = clang_getTokenSpelling(tu_file_->tu(), tok);
+    spelling_ = clang_getCString(s);
+    clang_disposeString(s);
+    str = spelling_.data();
+    len = spelling_.length();
+  }
+
+  // actually split up multi-line comments and send one at
+  // a time -- that way each line gets line numbers.
+  if (kind == CXToken_Comment || kind == CXToken_Literal) {
+    size_t i;
+    size_t begin = 0;
+    for (i = 0; i < len; ++i) {
+      if (str[i] == '\n') {
+        if (begin)
+          line++; column = 1;
+        write_token(w, file, tok, str + begin, i - begin, line, column);
+        begin = i + 1;
+      }
+    }
+    if (begin) {
+      line++;
+      column = 1;
+    }
+    str += begin;
+    len -= begin;
+  }
+  write_token(w, file, tok, str, len, line, column);
+}
+
+void
+Html_File::write_tokens(Render_Cache& w, Stream* stream) {
+  cur_line_ = 1;
+  cur_column_ = 1;
+
+  CXTranslationUnit tu = tu_file_->tu();
+  CXFile file = clang_getFile(tu, source_filename_.c_str());
+  unsigned length = tu_file_->length();
+
+  preprocessor_ = false;
+  include_ = false;
+
+  Mapped_File source;
+  if (const CXUnsavedFile* u = find_unsaved(unsaved_, num_unsaved_, source_filename_)) {
+    source_data_ = u->Contents;
+    source_size_ = u->Length;
+  }
+  else if (source.open(source_filename_)) {
+    source_data_ = source.data();
+    source_size_ = source.size();
+  }
+
+  w.begin();
+
+  // Tokenize a window at a time so only one window's tokens are alive,
+  // and, when streaming, only one window's events.  clang_tokenize()
+  // lexes a token that starts inside the range in full, even if it runs
+  // past the end, so each window starts where the last token of the
+  // previous one ended.
+  unsigned start = 0;
+  num_tokens_ = 0;
+  while (start < length) {
+    unsigned end = length - start > token_window_bytes ?
+      start + token_window_bytes : length;
+    CXSourceRange range
+      = clang_getRange(clang_getLocationForOffset(tu, file, start),
+                       clang_getLocationForOffset(tu, file, end));
+
+    CXToken *tokens;
+    unsigned num;
+    clang_tokenize(tu, range, &tokens, &num);
+    num_tokens_ += num;
+
+    for (unsigned i = 0; i < num; ++i)
+      write_comment_split(w, file, tokens[i]);
+
+    unsigned next = end;
+    if (num) {
+      CXFile last_file;
+      unsigned last_end;
+      clang_getExpansionLocation(clang_getRangeEnd(clang_getTokenExtent(tu, tokens[num-1])),
+                                 &last_file, 0, 0, &last_end);
+      if (last_file == file && last_end > next)
+        next = last_end;
+    }
+    clang_disposeTokens(tu, tokens, num);
+    start = next;
+    if (stream)
+      flush_window(w, *stream);
+  }
+
+  w.end();
+  if (stream)
+    flush_window(w, *stream);
+  source_data_ = 0;
+  source_size_ = 0;
+}
+
+template <class Writer>
+void
+Html_File::replay(Writer& w, const Render_Cache& cache) {
+  Render_Cache::Event e;
+  size_t pos = 0;
+  while (cache.next(pos, e)) {
+    switch (e.op) {
+    case (Render_Cache::Op_Begin): w.begin(); break;
+    case (Render_Cache::Op_End): w.end(); break;
+    case (Render_Cache::Op_Line): w.line(e.num); break;
+    case (Render_Cache::Op_Spaces): w.spaces(e.num); break;
+    case (Render_Cache::Op_Punctuation): w.punctuation(e.str, e.length); break;
+    case (Render_Cache::Op_Keyword): w.keyword(e.str, e.length); break;
+    case (Render_Cache::Op_Comment): w.comment(e.str, e.length); break;
+    case (Render_Cache::Op_Literal): w.literal(e.str, e.length); break;
+    case (Render_Cache::Op_Identifier): w.identifier(e.str, e.length); break;
+    case (Render_Cache::Op_Link):
+      w.link(std::string(e.key, e.key_length).c_str(), e.num, e.str, e.length);
+      break;
+    case (Render_Cache::Op_Debug): {
+      std::string label(e.key, e.key_length);
+      w.debug(e.num, label.c_str(), e.str, e.length, e.kind);
+      break;
+    }
+    case (Render_Cache::Op_Symbol): {
+      std::string key(e.key, e.key_length);
+      Frozen_Table::Match r;
+      if (!symbols_.lookup(key, r)) {
+        w.identifier(e.str, e.length);
+        break;
+      }
+      w.debug(__LINE__, "", key.data(), key.length(), e.kind);
+      add_xref(key, e.num);
+
+      // since we are linking to lines, no need to link to same line
+      if (r.href[0] || r.line != e.num)
+        w.link(r.href, r.line, e.str, e.length);
+      else
+        w.identifier(e.str, e.length);
+      break;
+    }
+    case (Render_Cache::Op_Xref): {
+      std::string key(e.key, e.key_length);
+      Frozen_Table::Match r;
+      if (xref_ && symbols_.lookup(key, r))
+        add_xref(key, e.num);
+      break;
+    }
+    case (Render_Cache::Op_Include): {
+      std::string includefile(e.key, e.key_length);
+      Frozen_Table::Match d;
+      if (files_.find(includefile) != files_.end()) {
+        std::string href = root_prefix(layout_) +
+          make_filename(includefile, html_dir_, prefix_, ".html", false, layout_);
+        w.link(href.c_str(), 0, e.str, e.length);
+      }
+      else if (symbols_.lookup(includefile, d)) {
+        // the tag file has the page's path, under its own html directory
+        std::string href = d.file;
+        if (!href.empty() && href[0] != '/')
+          href.insert(0, root_prefix(layout_));
+        w.link(href.c_str(), 0, e.str, e.length);
+      }
+      else
+        w.literal(e.str, e.length);
+      break;
+    }
+    }
+  }
+}
+
+void
+Html_File::flush_window(Render_Cache& w, Stream& stream) {
+  // a failed write shows in ferror() once the page is done
+  w.write_events(stream.cache);
+  if (stream.tokens)
+    replay(*stream.tokens, w);
+  else
+    replay(*stream.html, w);
+  w.clear();
+}
+
+void
+Html_File::write_page(FILE* f, const Render_Cache& cache) {
+  write_header(f);
+
+  if (format_ == Format_Token_Stream) {
+    Token_Stream_Writer w(f, root_prefix(layout_));
+    replay(w, cache);
+  }
+  else {
+    Html_Writer w(f);
+    replay(w, cache);
+  }
+
+  fprintf(f, "</div></div></body></html>");
+}
+
+// as write_page(), rendering the TU a window at a time
+void
+Html_File::stream_page(FILE* f, FILE* cache) {
+  write_header(f);
+
+  Render_Cache window;
+  Stream stream;
+  stream.cache = cache;
+  stream.html = 0;
+  stream.tokens = 0;
+  if (format_ == Format_Token_Stream) {
+    Token_Stream_Writer w(f, root_prefix(layout_));
+    stream.tokens = &w;
+    write_tokens(window, &stream);
+  }
+  else {
+    Html_Writer w(f);
+    stream.html = &w;
+    write_tokens(window, &stream);
+  }
+
+  fprintf(f, "</div></div></body></html>");
+}
+
+std::string
+Html_File::output_filename(void) const {
+  // links still point at the .html name; servers like nginx's gzip_static
+  // find the .gz next to it.
+  return gzip_ ? html_filename_ + ".gz" : html_filename_;
+}
+
+void
+Html_File::write_output(std::string& page) {
+  if (output_)
+    output_->submit(output_filename(), page, source_filename_);
+  else
+    Output_Writer().write_if_changed(output_filename(), page);
+}
+
+void
+Html_File::commit_output(const std::string& tmp) {
+  if (output_)
+    output_->submit_temp(tmp, output_filename(), source_filename_);
+  else
+    Output_Writer().commit_temp(tmp, output_filename());
+}
+
+// render into memory, through gzip_ if set
+bool
+Html_File::render_page(const Render_Cache& cache, std::string& page) {
+  char* buf = 0;
+  size_t len = 0;
+  FILE* f = open_memstream(&buf, &len);
+  if (f && gzip_) {
+    FILE* out = f;
+    f = gzip_->open(out);
+    if (!f)
+      fclose(out);
+  }
+  if (!f) {
+    free(buf);
+    return false;
+  }
+
+  write_page(f, cache);
+  bool ok = fclose(f) == 0;
+  if (ok)
+    page.assign(buf, len);
+  free(buf);
+  return ok;
+}
+
+void
+Html_File::load_tu(void) {
+  if (!tu_file_) {
+    if (unsaved_)
+      tu_file_ = new TU_File(argc_, argv_, idx_, source_filename_, unsaved_,
+                             num_unsaved_);
+    else
+      tu_file_ = new TU_File(argc_, argv_, idx_, source_filename_, object_dir_,
+                             prefix_, reparse_, layout_);
+    tu_file_->set_diagnostics(diags_);
+  }
+}
+
+bool
+Html_File::create_file(void) {
+  std::string tmp;
+  if (!create_temp(tmp))
+    return false;
+  commit_output(tmp);
+  return true;
+}
+
+bool
+Html_File::create_temp(std::string& page_tmp) {
+  std::string stamp = Render_Cache::source_stamp(source_filename_);
+  load_tu();
+
+  Output_Writer out;
+  std::string cache_tmp;
+  FILE* cache = out.open_temp(cache_filename_, cache_tmp);
+  if (!cache)
+    return false;
+  FILE* page = out.open_temp(output_filename(), page_tmp);
+  FILE* f = page;
+  if (f && gzip_) {
+    f = gzip_->open(page);
+    if (!f)
+      fclose(page);
+  }
+  if (!f) {
+    fclose(cache);
+    unlink(cache_tmp.c_str());
+    if (page)
+      unlink(page_tmp.c_str());
+    return false;
+  }
+
+  bool cached = Render_Cache::write_header(cache, stamp);
+  stream_page(f, cache);
+  // closing the gzip stream closes page too
+  bool ok = !ferror(f);
+  if (fclose(f) != 0)
+    ok = false;
+  if (ferror(cache))
+    cached = false;
+  if (fclose(cache) != 0)
+    cached = false;
+
+  // a cache that couldn't be written only costs the next relink a parse
+  if (cached)
+    out.commit_temp(cache_tmp, cache_filename_);
+  else
+    unlink(cache_tmp.c_str());
+  if (!ok) {
+    std::cerr << "error: could not write file: " << output_filename().c_str() << "\n";
+    unlink(page_tmp.c_str());
+    return false;
+  }
+  return true;
+}
+
+bool
+Html_File::relink_page(std::string& page) {
+  Render_Cache cache;
+  if (!cache.read(cache_filename_, source_filename_))
+    return false;
+  return render_page(cache, page);
+}
+
+bool
+Html_File::relink(void) {
+  std::string page;
+  if (!relink_page(page))
+    return false;
+  write_output(page);
+  return true;
+}
+
+bool
+Html_File::render(std::string& page) {
+  load_tu();
+  if (!tu_file_->tu())
+    return false;
+  Render_Cache cache;
+  write_tokens(cache);
+  return render_page(cache, page);
+}
+
+} // clang_doc
@@ -0,0 +1,181 @@
+/* -*- Mode: C++ -*-
+//
+// \file: Html_File.h
+//
+// \author: Don Allon Hinton <don.hinton@gmx.com>
+// \date: 13 Aug 2012 15:11:44 UTC
+//
+*/
+
+#ifndef INCLUDED_HTML_FILE_H
+#define INCLUDED_HTML_FILE_H
+
+#include "clang-c/Index.h"
+#include "Symbol_Table.h"
+
+#include <string>
+#include <set>
+#include <map>
+#include <vector>
+
+namespace clang_doc {
+
+class Async_Writer;
+class Diagnostic_Store;
+class Gzip_Stream;
+class Html_Writer;
+class Output_Writer;
+class Render_Cache;
+class Token_Stream_Writer;
+class TU_File;
+class Xref_Index;
+
+enum Output_Format {
+  Format_Html,          // fully marked up html
+  Format_Token_Stream   // compact token stream rendered by clang_doc.js
+};
+
+class Html_File {
+public:
+  Html_File(int argc,
+            char* argv[],
+            CXIndex ctx,
+            const std::vector<std::string>& includes,
+            const std::set<std::string>& files,
+            const Symbol_Table& symbols,
+            const std::string& source_filename,
+            const std::string& object_dir,
+            const std::string& html_dir,
+            const std::string& prefix);
+  ~Html_File(void);
+
+  const char* source_filename(void) const {return source_filename_.c_str();}
+  const char* html_dir(void) const {return html_dir_.c_str();}
+  const char* prefix(void) const {return prefix_.c_str();}
+  const char* html_filename(void) const {return html_filename_.c_str();}
+
+  // write the page and its render cache.  Each window of tokens goes
+  // out to both as soon as it is rendered, so memory is bounded by the
+  // window rather than the file.
+  bool create_file(void);
+  // as create_file(), but leave the page in tmp, to be committed with
+  // Async_Writer::submit_temp() or Output_Writer::commit_temp()
+  bool create_temp(std::string& tmp);
+  // rewrite the page from the render cache left by create_file(),
+  // resolving links against the current symbol table without parsing.
+  // returns false if there is no up to date cache.
+  bool relink(void);
+
+  // as relink(), but return the page instead of writing it to
+  // output_filename()
+  bool relink_page(std::string& page);
+  std::string output_filename(void) const;
+  // takes page over, see Async_Writer::submit()
+  void write_output(std::string& page);
+  // the page is already in tmp, see Async_Writer::submit_temp()
+  void commit_output(const std::string& tmp);
+
+  // tokens seen by the last create_file()
+  unsigned num_tokens(void) const {return num_tokens_;}
+
+  // ignore any saved TU and parse the source again
+  void set_reparse(bool reparse) {reparse_ = reparse;}
+
+  // render the page into memory instead of html_filename()
+  bool render(std::string& page);
+
+  // record every resolved reference in xref while rendering
+  void set_xref_index(Xref_Index* xref) {xref_ = xref;}
+
+  // collect the TU's diagnostics into diags instead of printing them
+  void set_diagnostics(Diagnostic_Store* diags) {diags_ = diags;}
+
+  void set_format(Output_Format format) {format_ = format;}
+
+  // where the page, its render cache and its TU go, and how its links
+  // are made
+  void set_layout(Layout layout);
+
+  // write html_filename().gz through gzip instead of html_filename()
+  void set_gzip(Gzip_Stream* gzip) {gzip_ = gzip;}
+
+  // hand pages to output instead of writing them here; pages are only
+  // replaced on disk if they changed either way
+  void set_output_writer(Async_Writer* output) {output_ = output;}
+
+  // parse from these buffers instead of the files on disk, and don't
+  // read or save a TU file; see Renderer
+  void set_unsaved_files(CXUnsavedFile* unsaved, unsigned num_unsaved) {
+    unsaved_ = unsaved;
+    num_unsaved_ = num_unsaved;
+  }
+
+private:
+  void write_header(FILE* f);
+  void write_token(Render_Cache& w, CXFile file, CXToken tok, const char* str,
+                   size_t len, unsigned line, unsigned column);
+  void write_comment_split(Render_Cache& w, CXFile file, CXToken tok);
+  // name as found in dir, taking unsaved buffers before the disk;
+  // false if it isn't there or dir can't be resolved
+  bool find_include(const std::string& dir, const std::string& name,
+                    std::string& includefile);
+  // where write_tokens() sends each window's events when streaming:
+  // appended to cache, and replayed into whichever writer is set
+  struct Stream {
+    FILE* cache;
+    Html_Writer* html;
+    Token_Stream_Writer* tokens;
+  };
+  void write_tokens(Render_Cache& w, Stream* stream = 0);
+  void flush_window(Render_Cache& w, Stream& stream);
+  template <class Writer>
+  void replay(Writer& w, const Render_Cache& cache);
+  void write_page(FILE* f, const Render_Cache& cache);
+  void stream_page(FILE* f, FILE* cache);
+  bool render_page(const Render_Cache& cache, std::string& page);
+  void load_tu(void);
+  void add_xref(const std::string& key, unsigned line);
+
+private:
+  int argc_;
+  char** argv_;
+  CXIndex idx_;
+  TU_File* tu_file_;
+  Xref_Index* xref_;
+  Diagnostic_Store* diags_;
+  Gzip_Stream* gzip_;
+  Async_Writer* output_;
+  unsigned cur_line_;
+  unsigned cur_column_;
+
+  const std::vector<std::string> includes_;
+  const std::set<std::string>& files_;
+  const Symbol_Table& symbols_;
+
+  std::string source_filename_;
+  std::string object_dir_;
+  std::string html_dir_;
+  std::string prefix_;
+  std::string html_filename_;
+  std::string cache_filename_;
+  Output_Format format_;
+  Layout layout_;
+  bool reparse_;
+  unsigned num_tokens_;
+
+  CXUnsavedFile* unsaved_;
+  unsigned num_unsaved_;
+
+  // the source text tokens are taken from
+  const char* source_data_;
+  size_t source_size_;
+  std::string spelling_;
+
+  // tokenizer state: the last token was '#', or '#include'
+  bool preprocessor_;
+  bool include_;
+};
+
+} // clang_doc
+
+#endif /* INCLUDED_HTML_FILE_H */
@@ -0,0 +1,64 @@
+/* -*- Mode: C++ -*-
+//
+// \file: Html_Writer.cpp
+//
+// \date: 19 Oct 2026 16:48:30 UTC
+//
+*/
+
+#include "Html_Writer.h"
+
+#include <string.h>
+
+namespace clang_doc {
+
+namespace {
+
+const char*
+entity(char c) {
+  switch (c) {
+  case ('<'):
+    return "&lt;";
+  case ('>'):
+    return "&gt;";
+  case ('&'):
+    return "&amp;";
+  case ('"'):
+    return "&quot;";
+  default:
+    return 0;
+  }
+}
+
+} // anonymous namespace
+
+size_t
+Html_Writer::write_escaped(FILE* f, const char* str, size_t len) {
+  size_t written = 0;
+  const char* begin = str;
+  const char* end = str + len;
+  for (const char* p = str; p != end; ++p) {
+    const char* e = entity(*p);
+    if (!e)
+      continue;
+    fwrite(begin, 1, p - begin, f);
+    written += p - begin;
+    written += fprintf(f, "%s", e);
+    begin = p + 1;
+  }
+  fwrite(begin, 1, end - begin, f);
+  written += end - begin;
+  return written;
+}
+
+size_t
+Html_Writer::escaped_length(const char* str, size_t len) {
+  size_t n = 0;
+  for (const char* p = str, *end = str + len; p != end; ++p) {
+    const char* e = entity(*p);
+    n += e ? strlen(e) : 1;
+  }
+  return n;
+}
+
+} // clang_doc
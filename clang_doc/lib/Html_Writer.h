@@ -0,0 +1,76 @@
+/* -*- Mode: C++ -*-
+//
+// \file: Html_Writer.h
+//
+// \date: 19 Oct 2026 16:48:12 UTC
+//
+// Output backends for Html_File.  Html_File walks the tokens of a file
+// once and hands each piece of output to a writer; the writer type is a
+// template parameter, so the choice of backend costs nothing per token.
+//
+// Html_Writer produces the traditional fully marked up page.
+//
+*/
+
+#ifndef INCLUDED_HTML_WRITER_H
+#define INCLUDED_HTML_WRITER_H
+
+#include <stdio.h>
+#include <string>
+
+namespace clang_doc {
+
+class Html_Writer {
+public:
+  explicit Html_Writer(FILE* f) : f_(f) {}
+
+  void begin(void) {fprintf(f_, "<pre class=\"fragment\">");}
+  void end(void) {fprintf(f_, "</pre>");}
+
+  void line(unsigned n) {
+    fprintf(f_, "\n<a name=\"l%05i\"></a>%05i", n, n);
+  }
+  void spaces(unsigned n) {
+    while (n--)
+      fputc(' ', f_);
+  }
+
+  void punctuation(const char* str, size_t len) {fwrite(str, 1, len, f_);}
+  void keyword(const char* str, size_t len) {
+    fprintf(f_, "<span class=\"keyword\">%.*s</span>", (int)len, str);
+  }
+  void comment(const char* str, size_t len) {
+    fprintf(f_, "<span class=\"comment\">");
+    write_escaped(f_, str, len);
+    fprintf(f_, "</span>");
+  }
+  void literal(const char* str, size_t len) {write_escaped(f_, str, len);}
+  void identifier(const char* str, size_t len) {
+    fprintf(f_, "<span class=\"code\">%.*s</span>", (int)len, str);
+  }
+
+  // line == 0 links to the file rather than to a line in it
+  void link(const char* href, unsigned line, const char* str, size_t len) {
+    if (line)
+      fprintf(f_, "<a class=\"code\" href=\"%s#l%05i\" title="">%.*s</a>",
+              href, line, (int)len, str);
+    else
+      fprintf(f_, "<a class=\"code\" href=\"%s\" title="">%.*s</a>",
+              href, (int)len, str);
+  }
+
+  void debug(int origin, const char* label, const char* str, size_t len, int kind) {
+    fprintf(f_, "<!-- origin line: %i : %s%.*s : kind = %i -->",
+            origin, label, (int)len, str, kind);
+  }
+
+  static size_t write_escaped(FILE* f, const char* str, size_t len);
+  static size_t escaped_length(const char* str, size_t len);
+
+private:
+  FILE* f_;
+};
+
+} // clang_doc
+
+#endif /* INCLUDED_HTML_WRITER_H */
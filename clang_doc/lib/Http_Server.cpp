@@ -0,0 +1,289 @@
+/* -*- Mode: C++ -*-
+//
+// \file: Http_Server.cpp
+//
+// \date: 19 Oct 2026 11:02:31 UTC
+//
+*/
+
+#include "Http_Server.h"
+#include "Clang_Doc.h"
+#include "Utils.h"
+
+#include <iostream>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+namespace clang_doc {
+
+namespace {
+
+void
+send_all(int fd, const char* data, size_t len) {
+  while (len > 0) {
+    ssize_t n = send(fd, data, len, MSG_NOSIGNAL);
+    if (n <= 0)
+      return;
+    data += n;
+    len -= n;
+  }
+}
+
+void
+send_response(int fd, const char* status, const std::string& type,
+              const std::string& body) {
+  char head[256];
+  int n = snprintf(head, sizeof(head),
+                   "HTTP/1.0 %s\r\n"
+                   "Content-Type: %s\r\n"
+                   "Content-Length: %lu\r\n"
+                   "Connection: close\r\n\r\n",
+                   status, type.c_str(), (unsigned long)body.length());
+  send_all(fd, head, n);
+  send_all(fd, body.data(), body.length());
+}
+
+// seconds a client may take to send its request, or to take the answer,
+// before it is dropped; requests are answered one at a time
+const int client_timeout_seconds = 10;
+
+int
+hex_digit(char c) {
+  if (c >= '0' && c <= '9')
+    return c - '0';
+  if (c >= 'a' && c <= 'f')
+    return c - 'a' + 10;
+  if (c >= 'A' && c <= 'F')
+    return c - 'A' + 10;
+  return -1;
+}
+
+// decode %xx escapes and drop any query string or fragment; returns false
+// for a malformed escape, or one that decodes to a NUL
+bool
+decode_path(const std::string& raw, std::string& path) {
+  for (size_t i = 0; i < raw.length(); ++i) {
+    char c = raw[i];
+    if (c == '?' || c == '#')
+      break;
+    if (c == '%') {
+      int hi = i + 2 < raw.length() ? hex_digit(raw[i+1]) : -1;
+      int lo = hi < 0 ? -1 : hex_digit(raw[i+2]);
+      if (lo < 0 || (hi == 0 && lo == 0))
+        return false;
+      path.push_back(static_cast<char>(hi * 16 + lo));
+      i += 2;
+      continue;
+    }
+    path.push_back(c);
+  }
+  return true;
+}
+
+bool
+read_file(const std::string& filename, std::string& contents) {
+  FILE* f = fopen(filename.c_str(), "rb");
+  if (!f)
+    return false;
+  char buf[8192];
+  size_t n;
+  while ((n = fread(buf, 1, sizeof(buf), f)) > 0)
+    contents.append(buf, n);
+  fclose(f);
+  return true;
+}
+
+} // anonymous namespace
+
+Http_Server::Http_Server(Clang_Doc& doc, unsigned short port, size_t cache_bytes)
+  : doc_(doc),
+    port_(port),
+    cache_bytes_(cache_bytes),
+    cache_used_(0) {
+  const std::set<std::string>& files = doc_.files();
+  for (std::set<std::string>::const_iterator i = files.begin(),
+         e = files.end(); i != e; ++i) {
+    std::string page = make_filename(*i, doc_.html_dir(), doc_.prefix(), ".html",
+                                     false, doc_.layout());
+    pages_.insert(std::pair<std::string, std::string>(page, *i));
+  }
+}
+
+int
+Http_Server::run(void) {
+  signal(SIGPIPE, SIG_IGN);
+
+  int sock = socket(AF_INET, SOCK_STREAM, 0);
+  if (sock < 0) {
+    perror("socket");
+    return 1;
+  }
+  int on = 1;
+  setsockopt(sock, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+
+  struct sockaddr_in addr;
+  memset(&addr, 0, sizeof(addr));
+  addr.sin_family = AF_INET;
+  addr.sin_port = htons(port_);
+  addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+  if (bind(sock, (struct sockaddr*)&addr, sizeof(addr)) != 0 ||
+      listen(sock, 16) != 0) {
+    perror("bind");
+    close(sock);
+    return 1;
+  }
+
+  std::cout << "serving " << pages_.size() << " files at http://127.0.0.1:"
+            << port_ << "/" << std::endl;
+
+  while (true) {
+    int fd = accept(sock, 0, 0);
+    if (fd < 0)
+      continue;
+    // a client that goes quiet must not hold up everyone else
+    struct timeval timeout;
+    timeout.tv_sec = client_timeout_seconds;
+    timeout.tv_usec = 0;
+    setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+    handle(fd);
+    close(fd);
+  }
+  return 0;
+}
+
+void
+Http_Server::handle(int fd) {
+  std::string request;
+  char buf[4096];
+  while (request.find("\r\n\r\n") == std::string::npos &&
+         request.length() < 16384) {
+    ssize_t n = recv(fd, buf, sizeof(buf), 0);
+    if (n <= 0)
+      break;
+    request.append(buf, n);
+  }
+
+  size_t sp1 = request.find(' ');
+  size_t sp2 = sp1 == std::string::npos ? sp1 : request.find(' ', sp1 + 1);
+  if (sp2 == std::string::npos) {
+    send_response(fd, "400 Bad Request", "text/plain", "bad request\n");
+    return;
+  }
+  if (request.compare(0, sp1, "GET") != 0) {
+    send_response(fd, "405 Method Not Allowed", "text/plain", "only GET is supported\n");
+    return;
+  }
+
+  std::string path;
+  if (!decode_path(request.substr(sp1 + 1, sp2 - sp1 - 1), path)) {
+    send_response(fd, "400 Bad Request", "text/plain", "bad request\n");
+    return;
+  }
+  std::string body;
+  std::string type = "text/html";
+  bool cached = false;
+  if (get_page(path, body, type, cached)) {
+    send_response(fd, "200 OK", type, body);
+    std::cout << "GET " << path.c_str() << " 200" << (cached ? " (cached)" : "")
+              << std::endl;
+  }
+  else {
+    send_response(fd, "404 Not Found", "text/plain", "not found\n");
+    std::cout << "GET " << path.c_str() << " 404" << std::endl;
+  }
+}
+
+bool
+Http_Server::get_page(const std::string& path, std::string& body,
+                      std::string& type, bool& cached) {
+  if (path == "/" || path == "/index.html") {
+    make_index(body);
+    return true;
+  }
+
+  size_t start = path.find_first_not_of('/');
+  if (start == std::string::npos)
+    return false;
+  std::string name = path.substr(start);
+  // pages may be one subdirectory down with Layout_Hashed, but never
+  // outside the html directory
+  if (name[0] == '.' || name.find("/.") != std::string::npos ||
+      name.find('/') != name.rfind('/'))
+    return false;
+
+  if (const std::string* page = cache_find(name)) {
+    body = *page;
+    cached = true;
+    return true;
+  }
+
+  std::map<std::string, std::string>::const_iterator i = pages_.find(name);
+  if (i != pages_.end()) {
+    if (!doc_.render_html_file(i->second, body))
+      return false;
+    cache_insert(name, body);
+    return true;
+  }
+
+  // anything else, e.g., doxygen.css, comes straight from the html directory
+  if (name.length() > 4 && name.compare(name.length() - 4, 4, ".css") == 0)
+    type = "text/css";
+  else if (name.length() > 3 && name.compare(name.length() - 3, 3, ".js") == 0)
+    type = "application/javascript";
+  return read_file(std::string(doc_.html_dir()) + "/" + name, body);
+}
+
+const std::string*
+Http_Server::cache_find(const std::string& path) {
+  std::map<std::string, Page_List::iterator>::iterator i = cache_.find(path);
+  if (i == cache_.end())
+    return 0;
+  lru_.splice(lru_.begin(), lru_, i->second);
+  return &i->second->second;
+}
+
+void
+Http_Server::cache_insert(const std::string& path, const std::string& body) {
+  if (body.length() > cache_bytes_)
+    return;
+
+  while (cache_used_ + body.length() > cache_bytes_ && !lru_.empty()) {
+    Page& old = lru_.back();
+    cache_used_ -= old.second.length();
+    cache_.erase(old.first);
+    lru_.pop_back();
+  }
+
+  lru_.push_front(Page(path, body));
+  cache_.insert(std::pair<std::string, Page_List::iterator>(path, lru_.begin()));
+  cache_used_ += body.length();
+}
+
+void
+Http_Server::make_index(std::string& body) {
+  body = "<html><head>"
+    "<meta http-equiv=\"Content-Type\" content=\"text/html;charset=iso-8859-1\"/>"
+    "<title>clang: File List</title>"
+    "<link href=\"doxygen.css\" rel=\"stylesheet\" type=\"text/css\"/>"
+    "</head><body>"
+    "<p class=\"title\">clang Code Documentation</p>"
+    "<div class=\"contents\"><h1>File List</h1><ul>";
+  for (std::map<std::string, std::string>::const_iterator i = pages_.begin(),
+         e = pages_.end(); i != e; ++i) {
+    body += "<li><a class=\"code\" href=\"" + html_escape(i->first) + "\">" +
+      html_escape(i->second) + "</a></li>";
+  }
+  body += "</ul></div></body></html>";
+}
+
+} // clang_doc
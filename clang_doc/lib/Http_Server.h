@@ -0,0 +1,58 @@
+/* -*- Mode: C++ -*-
+//
+// \file: Http_Server.h
+//
+// \date: 19 Oct 2026 11:02:17 UTC
+//
+// A minimal local http server that renders pages on demand.  The symbol
+// table is built once up front; pages are rendered through Html_File
+// only when requested, and kept in a bounded LRU cache.
+//
+*/
+
+#ifndef INCLUDED_HTTP_SERVER_H
+#define INCLUDED_HTTP_SERVER_H
+
+#include <list>
+#include <map>
+#include <string>
+
+namespace clang_doc {
+
+class Clang_Doc;
+
+class Http_Server {
+public:
+  Http_Server(Clang_Doc& doc, unsigned short port, size_t cache_bytes);
+
+  // accept and answer requests until the process is killed.
+  // returns non-zero if the server socket could not be set up.
+  int run(void);
+
+private:
+  typedef std::pair<std::string, std::string> Page;
+  typedef std::list<Page> Page_List;
+
+  void handle(int fd);
+  bool get_page(const std::string& path, std::string& body,
+                std::string& type, bool& cached);
+  const std::string* cache_find(const std::string& path);
+  void cache_insert(const std::string& path, const std::string& body);
+  void make_index(std::string& body);
+
+  Clang_Doc& doc_;
+  unsigned short port_;
+  size_t cache_bytes_;
+  size_t cache_used_;
+
+  // page name (as generated by make_filename) -> source file
+  std::map<std::string, std::string> pages_;
+
+  // most recently used pages are at the front
+  Page_List lru_;
+  std::map<std::string, Page_List::iterator> cache_;
+};
+
+} // clang_doc
+
+#endif /* INCLUDED_HTTP_SERVER_H */
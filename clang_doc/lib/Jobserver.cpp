@@ -0,0 +1,154 @@
+/* -*- Mode: C++ -*-
+//
+// \file: Jobserver.cpp
+//
+// \date: 20 Oct 2026 11:27:02 UTC
+//
+*/
+
+#include "Jobserver.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <iostream>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace clang_doc {
+
+namespace {
+
+bool
+is_fifo(int fd) {
+  struct stat st;
+  return fstat(fd, &st) == 0 && S_ISFIFO(st.st_mode);
+}
+
+} // namespace
+
+Jobserver::Jobserver(void)
+  : read_fd_(-1),
+    write_fd_(-1),
+    own_read_fd_(false),
+    own_write_fd_(false) {}
+
+Jobserver::~Jobserver(void) {
+  while (!tokens_.empty())
+    release();
+  disconnect();
+}
+
+void
+Jobserver::disconnect(void) {
+  if (own_read_fd_)
+    close(read_fd_);
+  if (own_write_fd_ && write_fd_ != read_fd_)
+    close(write_fd_);
+  read_fd_ = write_fd_ = -1;
+  own_read_fd_ = own_write_fd_ = false;
+}
+
+bool
+Jobserver::connect(void) {
+  const char* flags = getenv("MAKEFLAGS");
+  if (!flags)
+    return false;
+  std::string makeflags = flags;
+
+  // the last one given is the one that applies
+  std::string auth;
+  const char* const names[] = {"--jobserver-auth=", "--jobserver-fds="};
+  size_t best = std::string::npos;
+  for (unsigned n = 0; n < 2; ++n) {
+    size_t pos = makeflags.rfind(names[n]);
+    if (pos != std::string::npos && (best == std::string::npos || pos > best)) {
+      best = pos;
+      size_t start = pos + strlen(names[n]);
+      auth = makeflags.substr(start, makeflags.find(' ', start) - start);
+    }
+  }
+  if (auth.empty())
+    return false;
+
+  if (auth.compare(0, 5, "fifo:") == 0)
+    return open_fifo(auth.substr(5));
+
+  int r, w;
+  if (sscanf(auth.c_str(), "%d,%d", &r, &w) != 2 || r < 0 || w < 0)
+    return false;
+  return open_pipe(r, w);
+}
+
+bool
+Jobserver::open_fifo(const std::string& path) {
+  int fd = open(path.c_str(), O_RDWR | O_NONBLOCK);
+  if (fd < 0) {
+    std::cerr << "warning: could not open make jobserver fifo "
+              << path.c_str() << "\n";
+    return false;
+  }
+  read_fd_ = write_fd_ = fd;
+  own_read_fd_ = own_write_fd_ = true;
+  return true;
+}
+
+bool
+Jobserver::open_pipe(int read_fd, int write_fd) {
+  // make closes the pipe for commands it doesn't think are recursive,
+  // and the numbers may then belong to any file we happened to open
+  if (!is_fifo(read_fd) || !is_fifo(write_fd)) {
+    std::cerr << "warning: make jobserver unavailable, "
+              << "prefix the command with '+' in the makefile\n";
+    return false;
+  }
+
+  // make and its other children share the pipe, so it mustn't be made
+  // non-blocking for them; reopening it gives us a file description of
+  // our own.  Reading the shared one could block on a token another
+  // client took between poll() and read(), so without our own there's
+  // no jobserver.
+  char name[64];
+  snprintf(name, sizeof(name), "/proc/self/fd/%d", read_fd);
+  int fd = open(name, O_RDONLY | O_NONBLOCK);
+  if (fd < 0) {
+    std::cerr << "warning: could not reopen the make jobserver pipe, "
+              << "running without it\n";
+    return false;
+  }
+  read_fd_ = fd;
+  own_read_fd_ = true;
+  write_fd_ = write_fd;
+  return true;
+}
+
+bool
+Jobserver::acquire(void) {
+  if (read_fd_ < 0)
+    return false;
+  char token;
+  ssize_t n;
+  while ((n = read(read_fd_, &token, 1)) < 0 && errno == EINTR)
+    ;
+  if (n != 1)
+    return false;
+  tokens_.push_back(token);
+  return true;
+}
+
+void
+Jobserver::release(void) {
+  if (tokens_.empty())
+    return;
+  char token = tokens_[tokens_.length() - 1];
+  tokens_.erase(tokens_.length() - 1);
+  ssize_t n;
+  while ((n = write(write_fd_, &token, 1)) < 0 && errno == EINTR)
+    ;
+  if (n != 1)
+    std::cerr << "error: could not return a token to the make jobserver\n";
+}
+
+} // clang_doc
@@ -0,0 +1,58 @@
+/* -*- Mode: C++ -*-
+//
+// \file: Jobserver.h
+//
+// \date: 20 Oct 2026 11:26:40 UTC
+//
+// A GNU make jobserver client.  When clang_doc runs under make -j, make
+// passes a pipe (or, since make 4.4, a named fifo) in MAKEFLAGS holding
+// one token per free job slot.  Every process started by make owns one
+// implicit slot; each extra worker needs a token read from the pipe,
+// written back when its task is done.
+//
+*/
+
+#ifndef INCLUDED_JOBSERVER_H
+#define INCLUDED_JOBSERVER_H
+
+#include <string>
+
+namespace clang_doc {
+
+class Jobserver {
+public:
+  Jobserver(void);
+  // returns any tokens still held
+  ~Jobserver(void);
+
+  // find the jobserver in MAKEFLAGS; returns false if there isn't one
+  bool connect(void);
+  bool connected(void) const {return read_fd_ >= 0;}
+
+  // take a token if one is free, without waiting
+  bool acquire(void);
+  void release(void);
+  unsigned held(void) const {return tokens_.length();}
+
+  // readable when a token may be free
+  int poll_fd(void) const {return read_fd_;}
+
+private:
+  Jobserver(const Jobserver&);
+  Jobserver& operator=(const Jobserver&);
+
+  bool open_fifo(const std::string& path);
+  bool open_pipe(int read_fd, int write_fd);
+  void disconnect(void);
+
+  int read_fd_;
+  int write_fd_;
+  bool own_read_fd_;
+  bool own_write_fd_;
+  // make may hand out distinct tokens, so give back the ones we took
+  std::string tokens_;
+};
+
+} // clang_doc
+
+#endif /* INCLUDED_JOBSERVER_H */
@@ -0,0 +1,58 @@
+/* -*- Mode: C++ -*-
+//
+// \file: Mapped_File.cpp
+//
+// \date: 19 Oct 2026 15:22:03 UTC
+//
+*/
+
+#include "Mapped_File.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace clang_doc {
+
+Mapped_File::Mapped_File(void)
+  : data_(0),
+    size_(0) {}
+
+Mapped_File::~Mapped_File(void) {
+  close();
+}
+
+bool
+Mapped_File::open(const std::string& filename) {
+  close();
+
+  int fd = ::open(filename.c_str(), O_RDONLY);
+  if (fd < 0)
+    return false;
+
+  struct stat st;
+  if (fstat(fd, &st) != 0 || st.st_size == 0) {
+    ::close(fd);
+    return false;
+  }
+
+  void* p = mmap(0, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  ::close(fd);
+  if (p == MAP_FAILED)
+    return false;
+
+  data_ = static_cast<const char*>(p);
+  size_ = st.st_size;
+  return true;
+}
+
+void
+Mapped_File::close(void) {
+  if (data_)
+    munmap(const_cast<char*>(data_), size_);
+  data_ = 0;
+  size_ = 0;
+}
+
+} // clang_doc
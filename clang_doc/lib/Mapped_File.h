@@ -0,0 +1,42 @@
+/* -*- Mode: C++ -*-
+//
+// \file: Mapped_File.h
+//
+// \date: 19 Oct 2026 15:21:48 UTC
+//
+// Read-only memory mapping of a source file, so token text can be
+// taken as views into the file instead of copies.
+//
+*/
+
+#ifndef INCLUDED_MAPPED_FILE_H
+#define INCLUDED_MAPPED_FILE_H
+
+#include <stddef.h>
+#include <string>
+
+namespace clang_doc {
+
+class Mapped_File {
+public:
+  Mapped_File(void);
+  ~Mapped_File(void);
+
+  bool open(const std::string& filename);
+  void close(void);
+
+  bool is_open(void) const {return data_ != 0;}
+  const char* data(void) const {return data_;}
+  size_t size(void) const {return size_;}
+
+private:
+  Mapped_File(const Mapped_File&);
+  Mapped_File& operator=(const Mapped_File&);
+
+  const char* data_;
+  size_t size_;
+};
+
+} // clang_doc
+
+#endif /* INCLUDED_MAPPED_FILE_H */
@@ -0,0 +1,148 @@
+/* -*- Mode: C++ -*-
+//
+// \file: Output_Writer.cpp
+//
+// \date: 19 Oct 2026 20:05:40 UTC
+//
+*/
+
+#include "Output_Writer.h"
+#include "Mapped_File.h"
+
+#include <iostream>
+#include <stdio.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace clang_doc {
+
+Output_Writer::Output_Writer(void)
+  : written_(0),
+    skipped_(0) {}
+
+bool
+Output_Writer::unchanged(const std::string& filename, const char* data, size_t len) {
+  struct stat st;
+  if (stat(filename.c_str(), &st) != 0 || !S_ISREG(st.st_mode) ||
+      static_cast<size_t>(st.st_size) != len)
+    return false;
+  if (len == 0)
+    return true;
+
+  Mapped_File old;
+  if (!old.open(filename) || old.size() != len)
+    return false;
+  return memcmp(old.data(), data, len) == 0;
+}
+
+bool
+Output_Writer::write_in_place(const std::string& filename, const char* data,
+                              size_t len) {
+  FILE* f = fopen(filename.c_str(), "wb");
+  if (!f) {
+    std::cerr << "error: could not create file: " << filename.c_str() << "\n";
+    return false;
+  }
+  bool ok = fwrite(data, 1, len, f) == len;
+  if (fclose(f) != 0)
+    ok = false;
+  if (!ok)
+    std::cerr << "error: could not write file: " << filename.c_str() << "\n";
+  return ok;
+}
+
+FILE*
+Output_Writer::open_temp(const std::string& filename, std::string& tmp) {
+  char suffix[32];
+  snprintf(suffix, sizeof(suffix), ".tmp%ld", static_cast<long>(getpid()));
+  tmp = filename + suffix;
+
+  FILE* f = fopen(tmp.c_str(), "wb");
+  if (!f)
+    std::cerr << "error: could not create file: " << tmp.c_str() << "\n";
+  return f;
+}
+
+bool
+Output_Writer::replace(const std::string& filename, const std::string& tmp,
+                       const char* data, size_t len) {
+  // a rename would replace a symlink or a hard link with a file of its
+  // own, so those are written through; and nothing but a file is replaced
+  struct stat st;
+  bool exists = lstat(filename.c_str(), &st) == 0;
+  bool ok = true;
+  if (exists && (S_ISLNK(st.st_mode) ||
+                 (S_ISREG(st.st_mode) && st.st_nlink > 1))) {
+    ok = write_in_place(filename, data, len);
+    unlink(tmp.c_str());
+  }
+  else if (exists && !S_ISREG(st.st_mode)) {
+    std::cerr << "error: not a regular file: " << filename.c_str() << "\n";
+    unlink(tmp.c_str());
+    ok = false;
+  }
+  else {
+    // the replacement keeps the old file's permissions
+    if (exists)
+      chmod(tmp.c_str(), st.st_mode & 07777);
+    if (rename(tmp.c_str(), filename.c_str()) != 0) {
+      std::cerr << "error: could not write file: " << filename.c_str() << "\n";
+      unlink(tmp.c_str());
+      ok = false;
+    }
+  }
+  if (ok)
+    ++written_;
+  return ok;
+}
+
+bool
+Output_Writer::write_if_changed(const std::string& filename, const char* data, size_t len) {
+  if (unchanged(filename, data, len)) {
+    ++skipped_;
+    return true;
+  }
+
+  std::string tmp;
+  FILE* f = open_temp(filename, tmp);
+  if (!f)
+    return false;
+  bool ok = fwrite(data, 1, len, f) == len;
+  if (fclose(f) != 0)
+    ok = false;
+  if (!ok) {
+    std::cerr << "error: could not write file: " << filename.c_str() << "\n";
+    unlink(tmp.c_str());
+    return false;
+  }
+  return replace(filename, tmp, data, len);
+}
+
+bool
+Output_Writer::commit_temp(const std::string& tmp, const std::string& filename) {
+  Mapped_File file;
+  const char* data = "";
+  size_t len = 0;
+  if (file.open(tmp)) {
+    data = file.data();
+    len = file.size();
+  }
+  else {
+    struct stat st;
+    if (stat(tmp.c_str(), &st) != 0 || st.st_size != 0) {
+      std::cerr << "error: could not read file: " << tmp.c_str() << "\n";
+      unlink(tmp.c_str());
+      return false;
+    }
+  }
+
+  if (unchanged(filename, data, len)) {
+    unlink(tmp.c_str());
+    ++skipped_;
+    return true;
+  }
+  return replace(filename, tmp, data, len);
+}
+
+} // clang_doc
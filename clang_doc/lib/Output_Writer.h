@@ -0,0 +1,58 @@
+/* -*- Mode: C++ -*-
+//
+// \file: Output_Writer.h
+//
+// \date: 19 Oct 2026 20:05:12 UTC
+//
+// Writes generated files only when their contents change.  The new
+// contents are compared with the file already on disk; an unchanged file
+// is left alone, mtime and all, and a changed one is written to a
+// temporary file with the old one's mode and renamed over it.  A symlink
+// or a file with several hard links is written through instead, so the
+// links survive.
+//
+*/
+
+#ifndef INCLUDED_OUTPUT_WRITER_H
+#define INCLUDED_OUTPUT_WRITER_H
+
+#include <stddef.h>
+#include <stdio.h>
+#include <string>
+
+namespace clang_doc {
+
+class Output_Writer {
+public:
+  Output_Writer(void);
+
+  // returns false if the file needed writing and couldn't be written
+  bool write_if_changed(const std::string& filename, const char* data, size_t len);
+  bool write_if_changed(const std::string& filename, const std::string& data) {
+    return write_if_changed(filename, data.data(), data.length());
+  }
+
+  // for files too big to build in memory: write the new contents to the
+  // stream open_temp() returns, close it, and commit_temp() then treats
+  // them as write_if_changed() would, leaving tmp gone either way.
+  // open_temp() returns 0 if tmp can't be created.
+  FILE* open_temp(const std::string& filename, std::string& tmp);
+  bool commit_temp(const std::string& tmp, const std::string& filename);
+
+  unsigned written(void) const {return written_;}
+  unsigned skipped(void) const {return skipped_;}
+
+private:
+  bool unchanged(const std::string& filename, const char* data, size_t len);
+  bool write_in_place(const std::string& filename, const char* data, size_t len);
+  // filename's new contents are data, already written to tmp
+  bool replace(const std::string& filename, const std::string& tmp,
+               const char* data, size_t len);
+
+  unsigned written_;
+  unsigned skipped_;
+};
+
+} // clang_doc
+
+#endif /* INCLUDED_OUTPUT_WRITER_H */
@@ -0,0 +1,283 @@
+/* -*- Mode: C++ -*-
+//
+// \file: Render_Cache.cpp
+//
+// \date: 19 Oct 2026 22:19:02 UTC
+//
+*/
+
+#include "Render_Cache.h"
+#include "Mapped_File.h"
+#include "Output_Writer.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <sys/stat.h>
+
+namespace clang_doc {
+
+namespace {
+
+const char cache_magic[8] = {'C','D','R','C','0','0','0','2'};
+
+// the first line of a .defs file
+const char defs_stamp[] = "!source ";
+
+bool
+get_num(const std::string& data, size_t& pos, unsigned long long& n) {
+  n = 0;
+  unsigned shift = 0;
+  while (pos < data.length() && shift < 64) {
+    unsigned char c = static_cast<unsigned char>(data[pos++]);
+    n |= static_cast<unsigned long long>(c & 0x7f) << shift;
+    if (!(c & 0x80))
+      return true;
+    shift += 7;
+  }
+  return false;
+}
+
+bool
+get_str(const std::string& data, size_t& pos, const char*& str, size_t& len) {
+  unsigned long long n;
+  if (!get_num(data, pos, n) || n > data.length() - pos)
+    return false;
+  str = data.data() + pos;
+  len = n;
+  pos += n;
+  return true;
+}
+
+} // anonymous namespace
+
+void
+Render_Cache::put_num(unsigned long long n) {
+  while (n >= 0x80) {
+    data_.push_back(static_cast<char>((n & 0x7f) | 0x80));
+    n >>= 7;
+  }
+  data_.push_back(static_cast<char>(n));
+}
+
+void
+Render_Cache::put_str(const char* str, size_t len) {
+  put_num(len);
+  data_.append(str, len);
+}
+
+void
+Render_Cache::link(const char* href, unsigned line, const char* str, size_t len) {
+  put_op(Op_Link);
+  put_str(href, strlen(href));
+  put_num(line);
+  put_str(str, len);
+}
+
+void
+Render_Cache::debug(int origin, const char* label, const char* str, size_t len, int kind) {
+  put_op(Op_Debug);
+  put_num(origin);
+  put_str(label, strlen(label));
+  put_str(str, len);
+  put_num(kind);
+}
+
+void
+Render_Cache::symbol(const std::string& key, unsigned line, int kind,
+                     const char* str, size_t len) {
+  put_op(Op_Symbol);
+  put_str(key.data(), key.length());
+  put_num(line);
+  put_num(kind);
+  put_str(str, len);
+}
+
+void
+Render_Cache::xref(const std::string& key, unsigned line) {
+  put_op(Op_Xref);
+  put_str(key.data(), key.length());
+  put_num(line);
+}
+
+void
+Render_Cache::include(const std::string& filename, const char* str, size_t len) {
+  put_op(Op_Include);
+  put_str(filename.data(), filename.length());
+  put_str(str, len);
+}
+
+bool
+Render_Cache::next(size_t& pos, Event& event) const {
+  if (pos >= data_.length())
+    return false;
+
+  event.op = static_cast<Op>(static_cast<unsigned char>(data_[pos++]));
+  event.num = 0;
+  event.kind = 0;
+  event.key = 0;
+  event.key_length = 0;
+  event.str = 0;
+  event.length = 0;
+
+  unsigned long long n = 0;
+  unsigned long long kind = 0;
+  bool ok = true;
+  switch (event.op) {
+  case (Op_Begin):
+  case (Op_End):
+    break;
+  case (Op_Line):
+  case (Op_Spaces):
+    ok = get_num(data_, pos, n);
+    break;
+  case (Op_Punctuation):
+  case (Op_Keyword):
+  case (Op_Comment):
+  case (Op_Literal):
+  case (Op_Identifier):
+    ok = get_str(data_, pos, event.str, event.length);
+    break;
+  case (Op_Link):
+    ok = get_str(data_, pos, event.key, event.key_length) &&
+      get_num(data_, pos, n) &&
+      get_str(data_, pos, event.str, event.length);
+    break;
+  case (Op_Debug):
+    ok = get_num(data_, pos, n) &&
+      get_str(data_, pos, event.key, event.key_length) &&
+      get_str(data_, pos, event.str, event.length) &&
+      get_num(data_, pos, kind);
+    break;
+  case (Op_Symbol):
+    ok = get_str(data_, pos, event.key, event.key_length) &&
+      get_num(data_, pos, n) &&
+      get_num(data_, pos, kind) &&
+      get_str(data_, pos, event.str, event.length);
+    break;
+  case (Op_Xref):
+    ok = get_str(data_, pos, event.key, event.key_length) &&
+      get_num(data_, pos, n);
+    break;
+  case (Op_Include):
+    ok = get_str(data_, pos, event.key, event.key_length) &&
+      get_str(data_, pos, event.str, event.length);
+    break;
+  default:
+    ok = false;
+    break;
+  }
+  event.num = n;
+  event.kind = kind;
+  return ok;
+}
+
+bool
+Render_Cache::read(const std::string& filename,
+                   const std::string& source_filename) {
+  std::string stamp = source_stamp(source_filename);
+  Mapped_File file;
+  if (stamp.empty() || !file.open(filename) ||
+      file.size() < sizeof(cache_magic) ||
+      memcmp(file.data(), cache_magic, sizeof(cache_magic)) != 0)
+    return false;
+  std::string data(file.data() + sizeof(cache_magic),
+                   file.size() - sizeof(cache_magic));
+  size_t pos = 0;
+  const char* str;
+  size_t len;
+  if (!get_str(data, pos, str, len) || stamp.compare(0, stamp.length(), str, len))
+    return false;
+  data_.assign(data, pos, std::string::npos);
+  return true;
+}
+
+bool
+Render_Cache::write_header(FILE* f, const std::string& stamp) {
+  Render_Cache header;
+  header.put_str(stamp.data(), stamp.length());
+  return fwrite(cache_magic, sizeof(cache_magic), 1, f) == 1 &&
+    header.write_events(f);
+}
+
+bool
+Render_Cache::write_events(FILE* f) const {
+  return fwrite(data_.data(), 1, data_.length(), f) == data_.length();
+}
+
+std::string
+Render_Cache::source_stamp(const std::string& source_filename) {
+  struct stat st;
+  if (stat(source_filename.c_str(), &st) != 0)
+    return std::string();
+  char buf[64];
+  snprintf(buf, sizeof(buf), "%lld %lld", (long long)st.st_mtime,
+           (long long)st.st_size);
+  return buf;
+}
+
+// one "line column offset key" line per definition; keys can contain
+// spaces, so the key takes the rest of the line
+void
+Render_Cache::parse_definitions(const std::string& data,
+                                const std::string& source_filename,
+                                std::vector<Definition>& defs) {
+  size_t pos = 0;
+  while (pos < data.length()) {
+    size_t nl = data.find('\n', pos);
+    if (nl == std::string::npos)
+      nl = data.length();
+    std::string line(data, pos, nl - pos);
+    pos = nl + 1;
+
+    Definition def;
+    int n = 0;
+    if (sscanf(line.c_str(), "%u %u %u %n", &def.line, &def.column,
+               &def.offset, &n) != 3 || !n)
+      continue;
+    def.key = line.substr(n);
+    def.file = source_filename;
+    def.from_tag_file = false;
+    defs.push_back(def);
+  }
+}
+
+void
+Render_Cache::format_definitions(const std::vector<Definition>& defs,
+                                 std::string& out) {
+  for (std::vector<Definition>::const_iterator i = defs.begin(),
+         e = defs.end(); i != e; ++i) {
+    char buf[64];
+    snprintf(buf, sizeof(buf), "%u %u %u ", (*i).line, (*i).column, (*i).offset);
+    out += buf;
+    out += (*i).key;
+    out += '\n';
+  }
+}
+
+bool
+Render_Cache::read_definitions(const std::string& filename,
+                               const std::string& source_filename,
+                               std::vector<Definition>& defs) {
+  std::string stamp = source_stamp(source_filename);
+  Mapped_File file;
+  if (stamp.empty() || !file.open(filename))
+    return false;
+  std::string data(file.data(), file.size());
+  std::string first = defs_stamp + stamp + '\n';
+  if (data.compare(0, first.length(), first))
+    return false;
+  // the stamp line doesn't parse as a definition
+  parse_definitions(data, source_filename, defs);
+  return true;
+}
+
+bool
+Render_Cache::write_definitions(const std::string& filename,
+                                const std::string& stamp,
+                                const std::vector<Definition>& defs) {
+  std::string out = defs_stamp + stamp + '\n';
+  format_definitions(defs, out);
+  return Output_Writer().write_if_changed(filename, out);
+}
+
+} // clang_doc
@@ -0,0 +1,129 @@
+/* -*- Mode: C++ -*-
+//
+// \file: Render_Cache.h
+//
+// \date: 19 Oct 2026 22:18:36 UTC
+//
+// The rendered form of a page, before symbols are resolved.  Html_File
+// records the writer calls for a file here while it walks the TU, with
+// anything that depends on the symbol table (links through tag files,
+// include links, xref keys) kept as unresolved keys.  Replaying the
+// events against a symbol table produces the page, so a page can be
+// relinked against new tag files without libclang.
+//
+// Events are an op byte followed by varints and length prefixed strings.
+//
+// Both the cache and the .defs file record the source's stamp (its
+// mtime and size) from before it was parsed, and are only read back
+// while the source still has that stamp.  The cache's own mtime means
+// nothing, so an unchanged cache can be left alone on disk.
+//
+*/
+
+#ifndef INCLUDED_RENDER_CACHE_H
+#define INCLUDED_RENDER_CACHE_H
+
+#include "Tag_File.h"
+
+#include <stddef.h>
+#include <stdio.h>
+#include <string>
+#include <vector>
+
+namespace clang_doc {
+
+class Render_Cache {
+public:
+  enum Op {
+    Op_Begin,
+    Op_End,
+    Op_Line,          // num = line
+    Op_Spaces,        // num = count
+    Op_Punctuation,   // str
+    Op_Keyword,       // str
+    Op_Comment,       // str
+    Op_Literal,       // str
+    Op_Identifier,    // str
+    Op_Link,          // key = href, num = line, str
+    Op_Debug,         // num = origin, key = label, str, kind
+    Op_Symbol,        // key, num = line of the use, kind, str
+    Op_Xref,          // key, num = line of the use
+    Op_Include        // key = include file, str
+  };
+
+  struct Event {
+    Op op;
+    unsigned num;
+    int kind;
+    const char* key;
+    size_t key_length;
+    const char* str;
+    size_t length;
+  };
+
+  // writer interface, see Html_Writer
+  void begin(void) {put_op(Op_Begin);}
+  void end(void) {put_op(Op_End);}
+  void line(unsigned n) {put_op(Op_Line); put_num(n);}
+  void spaces(unsigned n) {put_op(Op_Spaces); put_num(n);}
+  void punctuation(const char* str, size_t len) {put_text(Op_Punctuation, str, len);}
+  void keyword(const char* str, size_t len) {put_text(Op_Keyword, str, len);}
+  void comment(const char* str, size_t len) {put_text(Op_Comment, str, len);}
+  void literal(const char* str, size_t len) {put_text(Op_Literal, str, len);}
+  void identifier(const char* str, size_t len) {put_text(Op_Identifier, str, len);}
+  void link(const char* href, unsigned line, const char* str, size_t len);
+  void debug(int origin, const char* label, const char* str, size_t len, int kind);
+
+  // a use of key, linked if the symbol table defines it
+  void symbol(const std::string& key, unsigned line, int kind,
+              const char* str, size_t len);
+  // a use of a local definition, indexed if key has external linkage
+  void xref(const std::string& key, unsigned line);
+  // an #include of filename
+  void include(const std::string& filename, const char* str, size_t len);
+
+  // pos starts at 0; returns false at the end or on a malformed event
+  bool next(size_t& pos, Event& event) const;
+
+  // returns false if filename is missing, malformed or was written for
+  // a different stamp than source_filename has now
+  bool read(const std::string& filename, const std::string& source_filename);
+
+  // the file is streamed out as it's rendered: write_header() once, then
+  // write_events() and clear() after each batch of events.  return false
+  // on error.
+  static bool write_header(FILE* f, const std::string& stamp);
+  bool write_events(FILE* f) const;
+  void clear(void) {data_.clear();}
+
+  // source_filename's mtime and size, empty if it can't be stat'ed.
+  // Take it before parsing, so an edit made during the parse shows.
+  static std::string source_stamp(const std::string& source_filename);
+
+  // the local definitions found in a file, so a relink doesn't need to
+  // parse it to rebuild the symbol table; read as for read()
+  static bool read_definitions(const std::string& filename,
+                               const std::string& source_filename,
+                               std::vector<Definition>& defs);
+  static bool write_definitions(const std::string& filename,
+                                const std::string& stamp,
+                                const std::vector<Definition>& defs);
+  // the same format in memory
+  static void format_definitions(const std::vector<Definition>& defs,
+                                 std::string& out);
+  static void parse_definitions(const std::string& data,
+                                const std::string& source_filename,
+                                std::vector<Definition>& defs);
+
+private:
+  void put_op(Op op) {data_.push_back(static_cast<char>(op));}
+  void put_num(unsigned long long n);
+  void put_str(const char* str, size_t len);
+  void put_text(Op op, const char* str, size_t len) {put_op(op); put_str(str, len);}
+
+  std::string data_;
+};
+
+} // clang_doc
+
+#endif /* INCLUDED_RENDER_CACHE_H */
@@ -0,0 +1,56 @@
+/* -*- Mode: C++ -*-
+//
+// \file: Renderer.cpp
+//
+// \date: 20 Oct 2026 09:12:37 UTC
+//
+*/
+
+#include "Renderer.h"
+#include "Diagnostic_Store.h"
+#include "Symbol_Table.h"
+
+namespace clang_doc {
+
+Renderer::Renderer(int argc,
+                   char* argv[],
+                   const Symbol_Table& symbols,
+                   const std::string& prefix)
+  : argc_(argc),
+    argv_(argv),
+    symbols_(symbols),
+    prefix_(strip_final_seps(prefix)),
+    format_(Format_Html),
+    layout_(Layout_Flat) {
+  find_include_directories(argc_, argv_, includes_);
+  idx_ = clang_createIndex(0, 0);
+}
+
+Renderer::~Renderer(void) {
+  clang_disposeIndex(idx_);
+}
+
+bool
+Renderer::render(const std::string& source_filename,
+                 CXUnsavedFile* unsaved,
+                 unsigned num_unsaved,
+                 std::string& page,
+                 Diagnostic_Store* diags) {
+  // an include of the page itself is the only one linked
+  std::set<std::string> files;
+  files.insert(source_filename);
+
+  // diagnostics are collected when html_file goes, so this must
+  // outlive it
+  Diagnostic_Store dropped;
+  // the directories are never touched, since nothing is saved
+  Html_File html_file(argc_, argv_, idx_, includes_, files, symbols_,
+                      source_filename, ".", ".", prefix_);
+  html_file.set_diagnostics(diags ? diags : &dropped);
+  html_file.set_format(format_);
+  html_file.set_layout(layout_);
+  html_file.set_unsaved_files(unsaved, num_unsaved);
+  return html_file.render(page);
+}
+
+} // clang_doc
@@ -0,0 +1,72 @@
+/* -*- Mode: C++ -*-
+//
+// \file: Renderer.h
+//
+// \date: 20 Oct 2026 09:12:37 UTC
+//
+// Renders pages from in-memory buffers for a caller embedding
+// libclangdoc, e.g. an editor or a documentation server.  The index
+// and the symbol table stay warm between calls.  Nothing is read from
+// or written to the object and html directories, and nothing is
+// printed.
+//
+*/
+
+#ifndef INCLUDED_RENDERER_H
+#define INCLUDED_RENDERER_H
+
+#include "clang-c/Index.h"
+#include "Html_File.h"
+#include "Utils.h"
+
+#include <set>
+#include <string>
+#include <vector>
+
+namespace clang_doc {
+
+class Diagnostic_Store;
+class Symbol_Table;
+
+class Renderer {
+public:
+  // argv holds the clang arguments used for every page, and must
+  // outlive the Renderer.  Links are resolved against symbols, which
+  // should be complete and frozen; hrefs are made relative to prefix.
+  // Renderers on different threads may share one frozen table.
+  Renderer(int argc,
+           char* argv[],
+           const Symbol_Table& symbols,
+           const std::string& prefix);
+  ~Renderer(void);
+
+  void set_format(Output_Format format) {format_ = format;}
+  void set_layout(Layout layout) {layout_ = layout;}
+
+  // render source_filename into page, taking its text, and that of any
+  // header, from unsaved where it's there.  diagnostics are collected
+  // into diags, or dropped if it's null.  returns false if the buffer
+  // couldn't be parsed.
+  bool render(const std::string& source_filename,
+              CXUnsavedFile* unsaved,
+              unsigned num_unsaved,
+              std::string& page,
+              Diagnostic_Store* diags = 0);
+
+private:
+  Renderer(const Renderer&);
+  Renderer& operator=(const Renderer&);
+
+  int argc_;
+  char** argv_;
+  CXIndex idx_;
+  const Symbol_Table& symbols_;
+  std::string prefix_;
+  std::vector<std::string> includes_;
+  Output_Format format_;
+  Layout layout_;
+};
+
+} // clang_doc
+
+#endif /* INCLUDED_RENDERER_H */
@@ -0,0 +1,161 @@
+/* -*- Mode: C++ -*-
+//
+// \file: Symbol_Image.cpp
+//
+// \date: 19 Oct 2026 21:40:51 UTC
+//
+*/
+
+#include "Symbol_Image.h"
+#include "Output_Writer.h"
+#include "Tag_File.h"
+#include "Utils.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/param.h>
+#include <sys/stat.h>
+#include <vector>
+
+namespace clang_doc {
+
+namespace {
+
+const char image_magic[8] = {'C','D','S','Y','M','T','0','1'};
+
+} // anonymous namespace
+
+Symbol_Image::Symbol_Image(void)
+  : header_(0),
+    entries_(0),
+    strings_(0) {}
+
+bool
+Symbol_Image::image_name(const std::string& dir, const std::string& tag_filename,
+                         std::string& name) {
+  char path[PATH_MAX];
+  struct stat st;
+  if (!realpath(tag_filename.c_str(), path) || stat(path, &st) != 0)
+    return false;
+
+  char id[128];
+  snprintf(id, sizeof(id), ":%lld:%lld:%llu:%llu",
+           (long long)st.st_size, (long long)st.st_mtime,
+           (unsigned long long)st.st_dev, (unsigned long long)st.st_ino);
+  std::string key = std::string(path) + id;
+
+  char base[64];
+  snprintf(base, sizeof(base), "/symtab-%016llx.bin",
+           hash_bytes(key.data(), key.length()));
+  name = strip_final_seps(dir) + base;
+  return true;
+}
+
+bool
+Symbol_Image::write(const std::string& filename,
+                    const std::map<std::string, Definition>& defs) {
+  std::vector<Symbol_Image_Entry> entries;
+  std::string strings;
+  // most definitions share a handful of files
+  std::map<std::string, uint32_t> files;
+
+  for (std::map<std::string, Definition>::const_iterator i = defs.begin(),
+         e = defs.end(); i != e; ++i) {
+    Symbol_Image_Entry entry;
+    entry.key_offset = strings.length();
+    entry.key_length = i->first.length();
+    strings += i->first;
+
+    std::map<std::string, uint32_t>::iterator f = files.find(i->second.file);
+    if (f == files.end()) {
+      f = files.insert(std::pair<std::string, uint32_t>(i->second.file,
+                                                         strings.length())).first;
+      strings += i->second.file;
+    }
+    entry.file_offset = f->second;
+    entry.file_length = i->second.file.length();
+    entry.line = i->second.line;
+    entries.push_back(entry);
+  }
+
+  Symbol_Image_Header header;
+  memset(&header, 0, sizeof(header));
+  memcpy(header.magic, image_magic, sizeof(header.magic));
+  header.num_entries = entries.size();
+  header.strings_size = strings.length();
+  header.strings_offset = sizeof(header) + entries.size() * sizeof(Symbol_Image_Entry);
+
+  std::string image(reinterpret_cast<const char*>(&header), sizeof(header));
+  if (!entries.empty())
+    image.append(reinterpret_cast<const char*>(&entries[0]),
+                 entries.size() * sizeof(Symbol_Image_Entry));
+  image += strings;
+
+  return Output_Writer().write_if_changed(filename, image);
+}
+
+bool
+Symbol_Image::open(const std::string& filename) {
+  if (!file_.open(filename))
+    return false;
+
+  header_ = reinterpret_cast<const Symbol_Image_Header*>(file_.data());
+  if (file_.size() < sizeof(*header_) ||
+      memcmp(header_->magic, image_magic, sizeof(image_magic)) != 0 ||
+      header_->strings_offset != sizeof(*header_) +
+        (uint64_t)header_->num_entries * sizeof(Symbol_Image_Entry) ||
+      header_->strings_offset + header_->strings_size != file_.size()) {
+    file_.close();
+    return false;
+  }
+  entries_ = reinterpret_cast<const Symbol_Image_Entry*>(file_.data() + sizeof(*header_));
+  strings_ = file_.data() + header_->strings_offset;
+  return true;
+}
+
+bool
+Symbol_Image::find(const std::string& key, std::string& file, unsigned& line) const {
+  if (!is_open())
+    return false;
+
+  // entries are sorted the way std::map<std::string> sorts its keys
+  size_t lo = 0;
+  size_t hi = header_->num_entries;
+  while (lo < hi) {
+    size_t mid = lo + (hi - lo) / 2;
+    const Symbol_Image_Entry& e = entries_[mid];
+    if ((uint64_t)e.key_offset + e.key_length > header_->strings_size ||
+        (uint64_t)e.file_offset + e.file_length > header_->strings_size)
+      return false;
+    size_t n = e.key_length < key.length() ? e.key_length : key.length();
+    int cmp = memcmp(string(e.key_offset), key.data(), n);
+    if (cmp == 0)
+      cmp = e.key_length < key.length() ? -1 : (e.key_length > key.length() ? 1 : 0);
+    if (cmp == 0) {
+      file.assign(string(e.file_offset), e.file_length);
+      line = e.line;
+      return true;
+    }
+    if (cmp < 0)
+      lo = mid + 1;
+    else
+      hi = mid;
+  }
+  return false;
+}
+
+bool
+Symbol_Image::get(size_t i, std::string& key, std::string& file,
+                  unsigned& line) const {
+  const Symbol_Image_Entry& e = entries_[i];
+  if ((uint64_t)e.key_offset + e.key_length > header_->strings_size ||
+      (uint64_t)e.file_offset + e.file_length > header_->strings_size)
+    return false;
+  key.assign(string(e.key_offset), e.key_length);
+  file.assign(string(e.file_offset), e.file_length);
+  line = e.line;
+  return true;
+}
+
+} // clang_doc
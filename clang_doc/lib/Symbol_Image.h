@@ -0,0 +1,79 @@
+/* -*- Mode: C++ -*-
+//
+// \file: Symbol_Image.h
+//
+// \date: 19 Oct 2026 21:40:22 UTC
+//
+// Read-only, position independent image of a tag file's entries, so
+// concurrent clang_doc processes reading the same tag file can map one
+// copy instead of each building their own std::map.  Images are named
+// after the tag file's path, size, mtime and inode, so an edited tag file
+// gets a new image.
+//
+// Format (native byte order):
+//
+//   Symbol_Image_Header
+//   num_entries Symbol_Image_Entry, sorted by key
+//   string pool, referenced by offset from its start
+//
+*/
+
+#ifndef INCLUDED_SYMBOL_IMAGE_H
+#define INCLUDED_SYMBOL_IMAGE_H
+
+#include "Mapped_File.h"
+
+#include <map>
+#include <string>
+#include <stdint.h>
+
+namespace clang_doc {
+
+struct Definition;
+
+struct Symbol_Image_Header {
+  char magic[8];
+  uint32_t num_entries;
+  uint32_t strings_size;
+  uint64_t strings_offset;
+};
+
+struct Symbol_Image_Entry {
+  uint32_t key_offset;
+  uint32_t key_length;
+  uint32_t file_offset;
+  uint32_t file_length;
+  uint32_t line;
+};
+
+class Symbol_Image {
+public:
+  Symbol_Image(void);
+
+  // image filename for tag_filename in dir; false if the tag file is gone
+  static bool image_name(const std::string& dir, const std::string& tag_filename,
+                         std::string& name);
+  static bool write(const std::string& filename,
+                    const std::map<std::string, Definition>& defs);
+
+  bool open(const std::string& filename);
+  bool is_open(void) const {return file_.is_open();}
+
+  bool find(const std::string& key, std::string& file, unsigned& line) const;
+
+  size_t size(void) const {return is_open() ? header_->num_entries : 0;}
+  // the i'th entry, in key order; false if it points outside the image
+  bool get(size_t i, std::string& key, std::string& file, unsigned& line) const;
+
+private:
+  const char* string(uint32_t offset) const {return strings_ + offset;}
+
+  Mapped_File file_;
+  const Symbol_Image_Header* header_;
+  const Symbol_Image_Entry* entries_;
+  const char* strings_;
+};
+
+} // clang_doc
+
+#endif /* INCLUDED_SYMBOL_IMAGE_H */
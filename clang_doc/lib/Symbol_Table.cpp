@@ -0,0 +1,105 @@
+/* -*- Mode: C++ -*-
+//
+// \file: Symbol_Table.cpp
+//
+// \date: 19 Oct 2026 21:07:12 UTC
+//
+*/
+
+#include "Symbol_Table.h"
+
+namespace clang_doc {
+
+Symbol_Table::Symbol_Table(void)
+  : frozen_(false) {}
+
+Symbol_Table::~Symbol_Table(void) {
+  for (std::vector<Tag_File*>::iterator i = tags_.begin(),
+         e = tags_.end(); i != e; ++i)
+    delete (*i);
+}
+
+bool
+Symbol_Table::add_tag_file(const std::string& filename) {
+  Tag_File* tag = new Tag_File(filename, image_dir_);
+  if (!tag->open()) {
+    delete tag;
+    return false;
+  }
+  tags_.push_back(tag);
+  return true;
+}
+
+void
+Symbol_Table::add_local(const Definition& def) {
+  local_.insert(std::pair<std::string, Definition>(def.key, def));
+}
+
+bool
+Symbol_Table::freeze(const std::string& prefix, Layout layout) {
+  frozen_ = true;
+  bool ok = true;
+
+  // everything a lookup may need is read now, so lookups never write
+  for (std::vector<Tag_File*>::iterator i = tags_.begin(),
+         e = tags_.end(); i != e; ++i) {
+    if (!(*i)->freeze(prefix, layout))
+      ok = false;
+  }
+
+  // tag files take precedence, so the local definitions they shadow go
+  std::vector<const Definition*> defs;
+  defs.reserve(local_.size());
+  for (Definition_Map::iterator i = local_.begin(); i != local_.end(); ) {
+    Frozen_Table::Match match;
+    if (find_in_tags(i->first, match))
+      local_.erase(i++);
+    else {
+      defs.push_back(&i->second);
+      ++i;
+    }
+  }
+  if (!frozen_local_.build(defs, prefix, layout, layout))
+    ok = false;
+  return ok;
+}
+
+bool
+Symbol_Table::find_in_tags(const std::string& key,
+                           Frozen_Table::Match& match) const {
+  for (std::vector<Tag_File*>::const_iterator i = tags_.begin(),
+         e = tags_.end(); i != e; ++i) {
+    if ((*i)->lookup(key, match))
+      return true;
+  }
+  return false;
+}
+
+bool
+Symbol_Table::lookup(const std::string& key, Frozen_Table::Match& match) const {
+  // freeze() dropped the local definitions a tag file also defines, so
+  // the order doesn't matter, and most keys are local
+  return frozen_local_.find(key, match) || find_in_tags(key, match);
+}
+
+size_t
+Symbol_Table::num_loaded_tag_files(void) const {
+  size_t n = 0;
+  for (std::vector<Tag_File*>::const_iterator i = tags_.begin(),
+         e = tags_.end(); i != e; ++i) {
+    if ((*i)->loaded())
+      ++n;
+  }
+  return n;
+}
+
+void
+Symbol_Table::unreadable_tag_files(std::vector<std::string>& filenames) const {
+  for (std::vector<Tag_File*>::const_iterator i = tags_.begin(),
+         e = tags_.end(); i != e; ++i) {
+    if ((*i)->failed())
+      filenames.push_back((*i)->filename());
+  }
+}
+
+} // clang_doc
@@ -0,0 +1,79 @@
+/* -*- Mode: C++ -*-
+//
+// \file: Symbol_Table.h
+//
+// \date: 19 Oct 2026 21:06:51 UTC
+//
+// Definitions from this run plus those listed in the -t tag files.  A
+// definition in a tag file takes precedence over a local one with the
+// same key.
+//
+// Once complete, the table is frozen: the local definitions and every
+// tag file's entries go into Frozen_Tables holding each definition's
+// href.  Lookups in a frozen table only read, without locking, so it
+// can be shared between threads.
+//
+*/
+
+#ifndef INCLUDED_SYMBOL_TABLE_H
+#define INCLUDED_SYMBOL_TABLE_H
+
+#include "Tag_File.h"
+
+#include <map>
+#include <string>
+#include <vector>
+
+namespace clang_doc {
+
+class Symbol_Table {
+public:
+  typedef std::map<std::string, Definition> Definition_Map;
+
+  Symbol_Table(void);
+  ~Symbol_Table(void);
+
+  // share the tables read from tag files with other processes through
+  // images in dir.  Must be called before add_tag_file().
+  void set_image_dir(const std::string& dir) {image_dir_ = dir;}
+
+  // returns false if filename can't be read
+  bool add_tag_file(const std::string& filename);
+  // ignored if def.key is already defined locally
+  void add_local(const Definition& def);
+
+  // no more add_local() calls; reads the tag files' entries and drops
+  // the local definitions they shadow.  hrefs are
+  // made relative to prefix, for pages arranged in layout.  returns
+  // false if some table had no perfect hash, in which case lookups in
+  // it fall back to a binary search.
+  bool freeze(const std::string& prefix, Layout layout);
+  bool frozen(void) const {return frozen_;}
+  // only after freeze(); safe to call from several threads at once
+  bool lookup(const std::string& key, Frozen_Table::Match& match) const;
+
+  // local definitions; once frozen, only those not shadowed by a tag
+  // file
+  const Definition_Map& local(void) const {return local_;}
+
+  size_t num_tag_files(void) const {return tags_.size();}
+  size_t num_loaded_tag_files(void) const;
+  // tag files whose entries couldn't be read
+  void unreadable_tag_files(std::vector<std::string>& filenames) const;
+
+private:
+  Symbol_Table(const Symbol_Table&);
+  Symbol_Table& operator=(const Symbol_Table&);
+
+  bool find_in_tags(const std::string& key, Frozen_Table::Match& match) const;
+
+  std::string image_dir_;
+  std::vector<Tag_File*> tags_;
+  Definition_Map local_;
+  bool frozen_;
+  Frozen_Table frozen_local_;
+};
+
+} // clang_doc
+
+#endif /* INCLUDED_SYMBOL_TABLE_H */
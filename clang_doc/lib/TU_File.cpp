@@ -0,0 +1,125 @@
+/* -*- Mode: C++ -*-
+//
+// \file: TU_File.cpp
+//
+// \author: Don Allon Hinton <don.hinton@gmx.com>
+// \date: 13 Aug 2012 17:54:34 UTC
+//
+*/
+
+#include "TU_File.h"
+#include "Diagnostic_Store.h"
+#include "Utils.h"
+
+#include <sys/stat.h>
+#include <iostream>
+
+namespace clang_doc {
+
+TU_File::TU_File(int argc,
+                 char* argv[],
+                 CXIndex idx,
+                 const std::string& source_filename,
+                 const std::string& object_dir,
+                 const std::string& prefix,
+                 bool reparse,
+                 Layout layout)
+  : idx_(idx),
+    tu_(0),
+    diags_(0),
+    argc_(argc),
+    argv_(argv),
+    source_filename_(source_filename),
+    length_(0),
+    reparse_ (reparse),
+    unsaved_(0),
+    num_unsaved_(0) {
+  object_dir_ = strip_final_seps(object_dir);
+  prefix_ = strip_final_seps(prefix);
+  tu_filename_ = make_filename(source_filename_, object_dir_, prefix_, ".tu",
+                               true, layout);
+
+  struct stat st;
+  if (stat(source_filename_.c_str(), &st) == 0)
+    length_ = st.st_size;
+
+  load_tu();
+}
+
+TU_File::TU_File(int argc,
+                 char* argv[],
+                 CXIndex idx,
+                 const std::string& source_filename,
+                 CXUnsavedFile* unsaved,
+                 unsigned num_unsaved)
+  : idx_(idx),
+    tu_(0),
+    diags_(0),
+    argc_(argc),
+    argv_(argv),
+    source_filename_(source_filename),
+    length_(0),
+    reparse_(true),
+    unsaved_(unsaved),
+    num_unsaved_(num_unsaved) {
+  struct stat st;
+  if (const CXUnsavedFile* u = find_unsaved(unsaved, num_unsaved, source_filename))
+    length_ = u->Length;
+  else if (stat(source_filename_.c_str(), &st) == 0)
+    length_ = st.st_size;
+
+  tu_ = clang_parseTranslationUnit(idx_,
+                                   source_filename_.c_str(),
+                                   argv_,
+                                   argc_,
+                                   unsaved_,
+                                   num_unsaved_,
+                                   clang_defaultEditingTranslationUnitOptions());
+}
+
+TU_File::~TU_File(void) {
+  if (tu_) {
+    if (diags_)
+      diags_->collect(tu_, source_filename_);
+    else
+      Diagnostic_Store::print_all(tu_);
+    clang_disposeTranslationUnit(tu_);
+  }
+}
+
+void
+TU_File::load_tu(void) {
+  struct stat st;
+
+  if (!reparse_ && stat(tu_filename_.c_str(), &st) == 0) {
+    std::cout << "found tu file: " << tu_filename_.c_str() << std::endl;
+    // Note that this will crash in 3.1 if the any of the source files have
+    // changed and it has to be regenerated.  I think the head works though.
+    // The solution right now is to delete the files from a previous run if
+    // any have changed, i.e., during development.
+    tu_ = clang_createTranslationUnit(idx_, tu_filename_.c_str());
+    return;
+  }
+  std::cout << "parsing file: " << source_filename_.c_str() << std::endl;
+
+  tu_ = clang_parseTranslationUnit(idx_,
+                                   source_filename_.c_str(),
+                                   argv_,
+                                   argc_,
+                                   0,
+                                   0,
+                                   clang_defaultEditingTranslationUnitOptions());//0);
+  if (tu_)
+  {
+    int ret = clang_saveTranslationUnit(tu_,
+                                        tu_filename_.c_str(),
+                                        clang_defaultSaveOptions(tu_));
+
+    if (ret == CXSaveError_None)
+    {
+      // what should we do here?
+    }
+  }
+}
+
+} // clang_doc
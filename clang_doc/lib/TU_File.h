@@ -11,10 +11,13 @@
 #define INCLUDED_TU_FILE_H
 
 #include "clang-c/Index.h"
+#include "Utils.h"
 #include <string>
 
 namespace clang_doc {
 
+class Diagnostic_Store;
+
 class TU_File {
 public:
   TU_File(int argc,
@@ -23,7 +26,18 @@ public:
           const std::string& source_filename,
           const std::string& object_dir,
           const std::string& prefix,
-          bool reparse = false);
+          bool reparse = false,
+          Layout layout = Layout_Flat);
+
+  // parse source_filename from the unsaved buffers (and any files on
+  // disk they don't cover), without reading or writing a .tu file, and
+  // without any console output
+  TU_File(int argc,
+          char* argv[],
+          CXIndex idx,
+          const std::string& source_filename,
+          CXUnsavedFile* unsaved,
+          unsigned num_unsaved);
 
   ~TU_File(void);
 
@@ -35,6 +49,9 @@ public:
   CXTranslationUnit tu(void) const {return tu_;}
   unsigned length(void) const {return length_;}
 
+  // collect diagnostics into diags instead of printing them
+  void set_diagnostics(Diagnostic_Store* diags) {diags_ = diags;}
+
 protected:
 
   void load_tu(void);
@@ -43,6 +60,7 @@ private:
 
   CXIndex idx_;
   CXTranslationUnit tu_;
+  Diagnostic_Store* diags_;
 
   int argc_;
   char** argv_;
@@ -54,6 +72,9 @@ private:
 
   unsigned length_;
   bool reparse_;
+
+  CXUnsavedFile* unsaved_;
+  unsigned num_unsaved_;
 };
 
 } // clang_doc
@@ -0,0 +1,186 @@
+/* -*- Mode: C++ -*-
+//
+// \file: Tag_File.cpp
+//
+// \date: 19 Oct 2026 20:52:40 UTC
+//
+*/
+
+#include "Tag_File.h"
+#include "Symbol_Image.h"
+#include "Utils.h"
+
+#include <fcntl.h>
+#include <iostream>
+#include <libgen.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/file.h>
+#include <unistd.h>
+
+namespace clang_doc {
+
+namespace {
+
+// fits comfortably in the 1024 byte fields older readers scan into
+const size_t bloom_chunk_bytes = 256;
+
+} // anonymous namespace
+
+Tag_File::Tag_File(const std::string& filename, const std::string& image_dir)
+  : filename_(filename),
+    image_dir_(image_dir),
+    layout_(Layout_Flat),
+    filtered_(false),
+    loaded_(false),
+    failed_(false),
+    entries_offset_(0) {
+  std::vector<char> path(filename.begin(), filename.end());
+  path.push_back(0);
+  html_path_ = dirname(&path[0]);
+}
+
+bool
+Tag_File::open(void) {
+  FILE* f = fopen(filename_.c_str(), "r");
+  if (!f)
+    return false;
+
+  char symbol[1024] = {0};
+  char value[1024] = {0};
+  unsigned num;
+  unsigned hashes;
+  unsigned long bits;
+  size_t decoded = 0;
+  bool params = false;
+  long offset = ftell(f);
+  while (fscanf(f, "%1023s %1023s %u\n", symbol, value, &num) == 3 &&
+         symbol[0] == '!') {
+    if (strcmp(symbol, "!bloom_params") == 0) {
+      params = sscanf(value, "%u:%lu", &hashes, &bits) == 2 &&
+        bloom_.reset(hashes, bits);
+    }
+    else if (strcmp(symbol, "!bloom") == 0 && params) {
+      decoded += bloom_.set_hex(num, value);
+    }
+    else if (strcmp(symbol, "!layout") == 0) {
+      layout_ = strcmp(value, "hashed") == 0 ? Layout_Hashed : Layout_Flat;
+    }
+    offset = ftell(f);
+  }
+  fclose(f);
+
+  // a partial filter would give false negatives, so fall back to reading
+  // the entries on the first lookup
+  filtered_ = params && decoded == bloom_.num_bytes();
+  entries_offset_ = offset;
+  return true;
+}
+
+bool
+Tag_File::freeze(const std::string& prefix, Layout page_layout) {
+  std::map<std::string, Definition> defs;
+  if ((image_dir_.empty() || !read_image(defs)) && !read_entries(defs))
+    return true;
+  loaded_ = true;
+
+  std::vector<const Definition*> entries;
+  entries.reserve(defs.size());
+  for (std::map<std::string, Definition>::const_iterator i = defs.begin(),
+         e = defs.end(); i != e; ++i)
+    entries.push_back(&i->second);
+  return table_.build(entries, prefix, page_layout, layout_);
+}
+
+bool
+Tag_File::read_image(std::map<std::string, Definition>& defs) {
+  std::string name;
+  if (!Symbol_Image::image_name(image_dir_, filename_, name))
+    return false;
+  Symbol_Image image;
+  if (!image.open(name)) {
+    int lock = ::open((name + ".lock").c_str(), O_RDWR | O_CREAT, 0666);
+    if (lock < 0)
+      return false;
+    flock(lock, LOCK_EX);
+    // someone else may have built it while we waited
+    bool ok = image.open(name);
+    if (!ok) {
+      std::map<std::string, Definition> all;
+      ok = read_entries(all) && Symbol_Image::write(name, all) && image.open(name);
+    }
+    flock(lock, LOCK_UN);
+    ::close(lock);
+    if (!ok)
+      return false;
+  }
+
+  // the image is sorted, so each entry goes at the end of the map
+  Definition def;
+  def.html_path = html_path_;
+  def.column = 0;
+  def.offset = 0;
+  def.from_tag_file = true;
+  for (size_t i = 0; i < image.size(); ++i) {
+    if (!image.get(i, def.key, def.file, def.line)) {
+      defs.clear();
+      return false;
+    }
+    defs.insert(defs.end(), std::pair<std::string, Definition>(def.key, def));
+  }
+  return true;
+}
+
+bool
+Tag_File::read_entries(std::map<std::string, Definition>& defs) {
+  FILE* f = fopen(filename_.c_str(), "r");
+  if (!f) {
+    failed_ = true;
+    return false;
+  }
+  fseek(f, entries_offset_, SEEK_SET);
+
+  char symbol[1024] = {0};
+  char file[1024] = {0};
+  unsigned line;
+  while (fscanf(f, "%1023s %1023s %u\n", symbol, file, &line) == 3) {
+    if (symbol[0] == '!')
+      continue;
+    Definition def;
+    def.key = symbol;
+    def.file = file;
+    def.html_path = html_path_;
+    def.line = line;
+    def.column = 0;
+    def.offset = 0;
+    def.from_tag_file = true;
+
+    defs.insert(std::pair<std::string, Definition>(def.key, def));
+  }
+  fclose(f);
+  return true;
+}
+
+void
+Tag_File::write(FILE* f, const std::vector<Definition>& entries,
+                Layout layout) {
+  Bloom_Filter bloom;
+  bloom.reset(entries.size());
+  for (std::vector<Definition>::const_iterator i = entries.begin(),
+         e = entries.end(); i != e; ++i)
+    bloom.add((*i).key);
+
+  if (layout == Layout_Hashed)
+    fprintf(f, "!layout hashed 0\n");
+  fprintf(f, "!bloom_params %u:%lu 0\n", bloom.num_hashes(),
+          (unsigned long)bloom.num_bits());
+  for (size_t off = 0; off < bloom.num_bytes(); off += bloom_chunk_bytes)
+    fprintf(f, "!bloom %s %lu\n", bloom.hex(off, bloom_chunk_bytes).c_str(),
+            (unsigned long)off);
+
+  for (std::vector<Definition>::const_iterator i = entries.begin(),
+         e = entries.end(); i != e; ++i)
+    fprintf(f, "%s %s %u\n", (*i).key.c_str(), (*i).file.c_str(), (*i).line);
+}
+
+} // clang_doc
@@ -0,0 +1,95 @@
+/* -*- Mode: C++ -*-
+//
+// \file: Tag_File.h
+//
+// \date: 19 Oct 2026 20:52:14 UTC
+//
+// A tag file lists the symbols a sub-project defines, one
+// "key file line" entry per line.  It starts with a Bloom filter over
+// the keys, written as lines older readers simply take for entries:
+//
+//   !bloom_params <hashes>:<bits> 0
+//   !bloom <hex> <byte offset>
+//
+// A sub-project whose pages use Layout_Hashed says so first, with
+//
+//   !layout hashed 0
+//
+// Opening a tag file only reads the filter.  The entries are read when
+// the symbol table is frozen, into a Frozen_Table with hrefs made for
+// the reading sub-project's prefix; lookups ask the filter first, so
+// keys the file doesn't define rarely probe its table.
+//
+// With an image directory set, the entries are read from a shared
+// Symbol_Image instead of being parsed from the tag file; the first
+// process to need it builds the image while the others wait.
+//
+*/
+
+#ifndef INCLUDED_TAG_FILE_H
+#define INCLUDED_TAG_FILE_H
+
+#include "Bloom_Filter.h"
+#include "Definition.h"
+#include "Frozen_Table.h"
+
+#include <stdio.h>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace clang_doc {
+
+class Tag_File {
+public:
+  Tag_File(const std::string& filename, const std::string& image_dir);
+
+  const char* filename(void) const {return filename_.c_str();}
+
+  // read the filter; returns false if the file can't be read
+  bool open(void);
+
+  bool may_contain(const std::string& key) const {
+    return !filtered_ || bloom_.may_contain(key);
+  }
+
+  // read the entries into a Frozen_Table.  returns false if no perfect
+  // hash was found for them; failed() says whether they were read.
+  bool freeze(const std::string& prefix, Layout page_layout);
+  // only after freeze(); only reads, so safe from several threads
+  bool lookup(const std::string& key, Frozen_Table::Match& match) const {
+    return may_contain(key) && table_.find(key, match);
+  }
+
+  bool loaded(void) const {return loaded_;}
+  // the entries couldn't be read
+  bool failed(void) const {return failed_;}
+  // of the pages the entries link to
+  Layout layout(void) const {return layout_;}
+
+  // write entries, preceded by a filter over their keys
+  static void write(FILE* f, const std::vector<Definition>& entries,
+                    Layout layout = Layout_Flat);
+
+private:
+  Tag_File(const Tag_File&);
+  Tag_File& operator=(const Tag_File&);
+
+  bool read_entries(std::map<std::string, Definition>& defs);
+  bool read_image(std::map<std::string, Definition>& defs);
+
+  std::string filename_;
+  std::string image_dir_;
+  std::string html_path_;
+  Bloom_Filter bloom_;
+  Layout layout_;
+  bool filtered_;
+  bool loaded_;
+  bool failed_;
+  long entries_offset_;
+  Frozen_Table table_;
+};
+
+} // clang_doc
+
+#endif /* INCLUDED_TAG_FILE_H */
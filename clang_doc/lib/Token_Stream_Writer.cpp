@@ -0,0 +1,168 @@
+/* -*- Mode: C++ -*-
+//
+// \file: Token_Stream_Writer.cpp
+//
+// \date: 19 Oct 2026 17:06:10 UTC
+//
+*/
+
+#include "Token_Stream_Writer.h"
+#include "Output_Writer.h"
+#include "Utils.h"
+
+namespace clang_doc {
+
+namespace {
+
+const char script[] =
+  "// generated by clang_doc -- renders the token streams in a page\n"
+  "(function () {\n"
+  "  var kinds = {k: 'keyword', c: 'comment', i: 'code'};\n"
+  "  function esc(s) {\n"
+  "    return s.replace(/&/g, '&amp;').replace(/</g, '&lt;')\n"
+  "            .replace(/>/g, '&gt;').replace(/\"/g, '&quot;');\n"
+  "  }\n"
+  "  function unesc(c) { return c == 'l' ? '<' : c == 'r' ? '\\r' : c; }\n"
+  "  function pad(n) { n = '' + n; while (n.length < 5) n = '0' + n; return n; }\n"
+  "  function spaces(n) { var s = ''; while (n--) s += ' '; return s; }\n"
+  "  function render() {\n"
+  "    var src = document.getElementById('clang_doc_tokens');\n"
+  "    if (!src) return;\n"
+  "    src = src.textContent;\n"
+  "    var links = JSON.parse(document.getElementById('clang_doc_links').textContent);\n"
+  "    var out = [], line = 0, i = 0, n = src.length, special = /[\\n~|\\\\]/g;\n"
+  "    while (i < n) {\n"
+  "      special.lastIndex = i;\n"
+  "      var m = special.exec(src), j = m ? m.index : n;\n"
+  "      if (j > i) out.push(esc(src.substring(i, j)));\n"
+  "      if (!m) break;\n"
+  "      var c = src.charAt(j);\n"
+  "      i = j + 1;\n"
+  "      if (c == '\\n') {\n"
+  "        ++line;\n"
+  "        out.push('\\n<a name=\"l' + pad(line) + '\"></a>' + pad(line));\n"
+  "      } else if (c == '~') {\n"
+  "        out.push(spaces(parseInt(src.charAt(i++), 36)));\n"
+  "      } else if (c == '\\\\') {\n"
+  "        out.push(esc(unesc(src.charAt(i++))));\n"
+  "      } else {\n"
+  "        var kind = src.charAt(i++), href = null, text = '';\n"
+  "        if (kind == 'a') {\n"
+  "          var colon = src.indexOf(':', i);\n"
+  "          href = links[+src.substring(i, colon)];\n"
+  "          i = colon + 1;\n"
+  "        }\n"
+  "        while (i < n) {\n"
+  "          c = src.charAt(i++);\n"
+  "          if (c == '|') break;\n"
+  "          text += c == '\\\\' ? unesc(src.charAt(i++)) : c;\n"
+  "        }\n"
+  "        text = esc(text);\n"
+  "        if (href != null)\n"
+  "          out.push('<a class=\"code\" href=\"' + esc(href) + '\">' + text + '</a>');\n"
+  "        else\n"
+  "          out.push('<span class=\"' + kinds[kind] + '\">' + text + '</span>');\n"
+  "      }\n"
+  "    }\n"
+  "    document.getElementById('clang_doc_src').innerHTML = out.join('');\n"
+  "    var a = location.hash && document.getElementsByName(location.hash.substring(1))[0];\n"
+  "    if (a) a.scrollIntoView();\n"
+  "  }\n"
+  "  if (document.readyState == 'loading')\n"
+  "    document.addEventListener('DOMContentLoaded', render);\n"
+  "  else\n"
+  "    render();\n"
+  "})();\n";
+
+} // anonymous namespace
+
+void
+Token_Stream_Writer::begin(void) {
+  fprintf(f_, "<pre class=\"fragment\" id=\"clang_doc_src\"></pre>");
+  fprintf(f_, "<script type=\"text/x-clang-doc\" id=\"clang_doc_tokens\">");
+}
+
+void
+Token_Stream_Writer::end(void) {
+  fprintf(f_, "</script>");
+  fprintf(f_, "<script type=\"application/json\" id=\"clang_doc_links\">[");
+  for (std::vector<std::string>::const_iterator i = links_.begin(),
+         e = links_.end(); i != e; ++i) {
+    if (i != links_.begin())
+      fputc(',', f_);
+    write_json_string(f_, *i);
+  }
+  fprintf(f_, "]</script>");
+  fprintf(f_, "<script type=\"text/javascript\" src=\"%sclang_doc.js\"></script>",
+          root_.c_str());
+}
+
+void
+Token_Stream_Writer::spaces(unsigned n) {
+  while (n >= 4) {
+    unsigned run = n < 35 ? n : 35;
+    fputc('~', f_);
+    fputc(run < 10 ? '0' + run : 'a' + run - 10, f_);
+    n -= run;
+  }
+  while (n--)
+    fputc(' ', f_);
+}
+
+void
+Token_Stream_Writer::write_text(const char* str, size_t len) {
+  const char* begin = str;
+  const char* end = str + len;
+  for (const char* p = str; p != end; ++p) {
+    char c = *p;
+    if (c != '\\' && c != '|' && c != '~' && c != '<' && c != '\r' && c != '\n')
+      continue;
+    fwrite(begin, 1, p - begin, f_);
+    fputc('\\', f_);
+    fputc(c == '<' ? 'l' : c == '\r' ? 'r' : c, f_);
+    begin = p + 1;
+  }
+  fwrite(begin, 1, end - begin, f_);
+}
+
+void
+Token_Stream_Writer::write_span(char kind, const char* str, size_t len) {
+  fputc('|', f_);
+  fputc(kind, f_);
+  write_text(str, len);
+  fputc('|', f_);
+}
+
+void
+Token_Stream_Writer::link(const char* href, unsigned line,
+                          const char* str, size_t len) {
+  std::string target = href;
+  if (line) {
+    char anchor[32];
+    snprintf(anchor, sizeof(anchor), "#l%05i", line);
+    target += anchor;
+  }
+
+  std::map<std::string, unsigned>::iterator i = link_ids_.find(target);
+  unsigned id;
+  if (i != link_ids_.end()) {
+    id = i->second;
+  }
+  else {
+    id = links_.size();
+    links_.push_back(target);
+    link_ids_.insert(std::pair<std::string, unsigned>(target, id));
+  }
+
+  fprintf(f_, "|a%u:", id);
+  write_text(str, len);
+  fputc('|', f_);
+}
+
+bool
+Token_Stream_Writer::write_script(const std::string& html_dir) {
+  std::string filename = html_dir + "/clang_doc.js";
+  return Output_Writer().write_if_changed(filename, script, sizeof(script) - 1);
+}
+
+} // clang_doc
@@ -0,0 +1,74 @@
+/* -*- Mode: C++ -*-
+//
+// \file: Token_Stream_Writer.h
+//
+// \date: 19 Oct 2026 17:05:54 UTC
+//
+// Compact output backend for Html_File.  Instead of marking up every
+// token, the page carries a token stream that clang_doc.js turns into
+// the same html in the browser.  The stream is embedded in the page so
+// existing links (foo.cpp.html#l00042) keep working.
+//
+// Stream format, one source line per '\n' (the stream starts with one):
+//
+//   text          plain text (punctuation, literals, single spaces)
+//   ~c            a run of spaces, c is the count in base 36 (4..35)
+//   |ktext|       keyword
+//   |ctext|       comment
+//   |itext|       identifier
+//   |aN:text|     link to entry N of the page's link table
+//   \c            escaped character: \\ \| \~ \l ('<') \r
+//
+// The link table is a json array of the hrefs, taken as they are.
+//
+*/
+
+#ifndef INCLUDED_TOKEN_STREAM_WRITER_H
+#define INCLUDED_TOKEN_STREAM_WRITER_H
+
+#include <map>
+#include <stdio.h>
+#include <string>
+#include <vector>
+
+namespace clang_doc {
+
+class Token_Stream_Writer {
+public:
+  // root leads from the page back to the html directory, where
+  // write_script() put clang_doc.js
+  explicit Token_Stream_Writer(FILE* f, const std::string& root = std::string())
+    : f_(f), root_(root) {}
+
+  void begin(void);
+  void end(void);
+
+  void line(unsigned) {fputc('\n', f_);}
+  void spaces(unsigned n);
+
+  void punctuation(const char* str, size_t len) {write_text(str, len);}
+  void keyword(const char* str, size_t len) {write_span('k', str, len);}
+  void comment(const char* str, size_t len) {write_span('c', str, len);}
+  void literal(const char* str, size_t len) {write_text(str, len);}
+  void identifier(const char* str, size_t len) {write_span('i', str, len);}
+  void link(const char* href, unsigned line, const char* str, size_t len);
+
+  // debugging comments are not carried in the stream
+  void debug(int, const char*, const char*, size_t, int) {}
+
+  // write clang_doc.js, which renders the streams, to html_dir
+  static bool write_script(const std::string& html_dir);
+
+private:
+  void write_text(const char* str, size_t len);
+  void write_span(char kind, const char* str, size_t len);
+
+  FILE* f_;
+  std::string root_;
+  std::map<std::string, unsigned> link_ids_;
+  std::vector<std::string> links_;
+};
+
+} // clang_doc
+
+#endif /* INCLUDED_TOKEN_STREAM_WRITER_H */
@@ -0,0 +1,213 @@
+/* -*- Mode: C++ -*-
+//
+// \file: Utils.cpp
+//
+// \author: Don Allon Hinton <don.hinton@gmx.com>
+// \date: 16 Aug 2012 09:53:06 UTC
+//
+*/
+
+#include "Utils.h"
+
+#include <errno.h>
+#include <iostream>
+#include <stdio.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+
+namespace clang_doc {
+
+namespace {
+
+std::string
+fullyScopedName_i (const CXCursor& cursor) {
+  std::string str;
+
+  CXCursor parent = clang_getCursorSemanticParent(cursor);
+  if (!clang_Cursor_isNull(parent) && parent.kind != CXCursor_TranslationUnit)
+    str += fullyScopedName(parent);
+
+  CXString cxs = clang_getCursorDisplayName(cursor);
+  const char* s = clang_getCString(cxs);
+
+  if (s[0] != 0) {
+    if (str[0] != 0) // prevent initial "::"
+      str += "::";
+    str += s;
+  }
+
+  clang_disposeString(cxs);
+  return str;
+}
+
+} // anonomous namespace
+
+std::string
+fullyScopedName (const CXCursor& cursor) {
+  std::string str = fullyScopedName_i (cursor);
+
+  size_t pos = str.find_first_of (' ');
+  while (pos != std::string::npos) {
+    str[pos] = '@';
+    pos = str.find_first_of(' ', pos+1);
+  }
+  return str;
+}
+
+const std::string
+make_filename(const std::string& file,
+              const std::string& directory,
+              const std::string& prefix,
+              const std::string& suffix,
+              bool full_path,
+              Layout layout) {
+  //std::cout << "make_filename: " << file.c_str() << "\n";
+
+#if 1
+  // FIXME: use regex to strip off common root
+  size_t len = prefix.length();
+  if (len > 0 && len < file.length()) ++len; // add separator
+  std::string sub = file.substr (len);
+#else
+  std::string sub = file;
+#endif
+
+  size_t pos = sub.find_first_of ('/');
+  while (pos != std::string::npos) {
+    sub[pos] = '_';
+    pos = sub.find_first_of('/', pos+1);
+  }
+
+  std::string out_file;
+  if (full_path)
+    out_file += directory + "/";
+
+  if (layout == Layout_Hashed) {
+    char shard[4];
+    snprintf(shard, sizeof(shard), "%02x/",
+             static_cast<unsigned>(hash_bytes(sub.data(), sub.length()) & 0xff));
+    out_file += shard;
+  }
+
+  out_file += sub + suffix;
+
+  return out_file;
+}
+
+const std::string
+strip_final_seps (const std::string& str) {
+  size_t last = str.length();
+  while (str[last-1] == '/') --last;
+  return str.substr (0, last);
+}
+
+unsigned long long
+hash_bytes (const char* data, size_t len) {
+  unsigned long long h = 14695981039346656037ULL;
+  for (size_t i = 0; i < len; ++i) {
+    h ^= static_cast<unsigned char>(data[i]);
+    h *= 1099511628211ULL;
+  }
+  return h;
+}
+
+void
+find_include_directories (int argc, char* argv[],
+                          std::vector<std::string>& includes) {
+  bool getnext = false;
+  bool found = false;
+  int index = 0;
+  for (int i = 0; i < argc; ++i) {
+    char* p = argv[i];
+    if (getnext) {
+      found = true;
+      getnext = false;
+    } else {
+      if (p[0] == '-' && p[1] == 'I') {
+        if (p[2] == 0) {
+          index = 0;
+          getnext = true;
+          continue;
+        }
+        index = 2;
+        found = true;
+      }
+    }
+
+    if (found) {
+      found = false;
+      includes.push_back (p+index);
+    }
+  }
+}
+
+const CXUnsavedFile*
+find_unsaved (const CXUnsavedFile* unsaved, unsigned num_unsaved,
+              const std::string& filename) {
+  for (unsigned i = 0; i < num_unsaved; ++i) {
+    if (unsaved[i].Filename && filename == unsaved[i].Filename)
+      return &unsaved[i];
+  }
+  return 0;
+}
+
+bool
+make_shard_dirs (const std::string& dir) {
+  for (unsigned i = 0; i < 256; ++i) {
+    char shard[8];
+    snprintf(shard, sizeof(shard), "/%02x", i);
+    std::string path = dir + shard;
+    if (mkdir(path.c_str(), 0777) != 0 && errno != EEXIST) {
+      std::cerr << "error: could not create directory: " << path.c_str() << "\n";
+      return false;
+    }
+  }
+  return true;
+}
+
+double
+wall_time (void) {
+  struct timeval tv;
+  gettimeofday(&tv, 0);
+  return tv.tv_sec + tv.tv_usec / 1e6;
+}
+
+std::string
+html_escape(const std::string& s) {
+  std::string out;
+  out.reserve(s.length());
+  for (std::string::const_iterator i = s.begin(), e = s.end(); i != e; ++i) {
+    switch (*i) {
+    case ('<'): out += "&lt;"; break;
+    case ('>'): out += "&gt;"; break;
+    case ('&'): out += "&amp;"; break;
+    case ('"'): out += "&quot;"; break;
+    default: out += *i; break;
+    }
+  }
+  return out;
+}
+
+void
+write_json_string(FILE* f, const std::string& s) {
+  fputc('"', f);
+  for (std::string::const_iterator i = s.begin(), e = s.end(); i != e; ++i) {
+    unsigned char c = *i;
+    switch (c) {
+    case ('"'): fputs("\\\"", f); break;
+    case ('\\'): fputs("\\\\", f); break;
+    case ('\n'): fputs("\\n", f); break;
+    case ('\t'): fputs("\\t", f); break;
+    case ('<'): fputs("\\u003c", f); break;
+    default:
+      if (c < 0x20)
+        fprintf(f, "\\u%04x", c);
+      else
+        fputc(c, f);
+      break;
+    }
+  }
+  fputc('"', f);
+}
+
+} // clang_doc
@@ -0,0 +1,85 @@
+/* -*- Mode: C++ -*-
+//
+// \file: Utils.h
+//
+// \author: Don Allon Hinton <don.hinton@gmx.com>
+// \date: 16 Aug 2012 09:55:34 UTC
+//
+//
+*/
+
+#ifndef INCLUDED_UTILS_H
+#define INCLUDED_UTILS_H
+
+#include "clang-c/Index.h"
+#include <stdio.h>
+#include <string>
+#include <vector>
+
+#define STR(x) (x?x:"xxxxxxxxxxxxxxxxxx")
+
+namespace clang_doc {
+
+// how pages and object files are arranged in their directories
+enum Layout {
+  Layout_Flat,    // all in the one directory
+  Layout_Hashed   // spread over 256 subdirectories, 00 to ff, picked by
+                  // a hash of the name
+};
+
+std::string
+fullyScopedName(const CXCursor& cursor);
+
+// with Layout_Hashed, the name is prefixed with its subdirectory, which
+// is the same for every suffix
+const std::string
+make_filename(const std::string& file,
+              const std::string& html_dir,
+              const std::string& prefix,
+              const std::string& suffix,
+              bool full_path = true,
+              Layout layout = Layout_Flat);
+
+// what relative links from a page go through to get back to the top of
+// its html directory
+inline const char*
+root_prefix(Layout layout) {return layout == Layout_Hashed ? "../" : "";}
+
+// the -I directories in a clang command line
+void
+find_include_directories(int argc, char* argv[],
+                         std::vector<std::string>& includes);
+
+// the buffer in unsaved for filename, if any
+const CXUnsavedFile*
+find_unsaved(const CXUnsavedFile* unsaved, unsigned num_unsaved,
+             const std::string& filename);
+
+// make the subdirectories of dir that Layout_Hashed uses
+bool
+make_shard_dirs(const std::string& dir);
+
+const std::string
+strip_final_seps(const std::string& str);
+
+// 64 bit FNV-1a
+unsigned long long
+hash_bytes(const char* data, size_t len);
+
+// s with &, <, > and " replaced by entities, for html text and
+// attribute values
+std::string
+html_escape(const std::string& s);
+
+// s as a quoted json string; '<' is escaped too, so the string can sit
+// inside a <script> element
+void
+write_json_string(FILE* f, const std::string& s);
+
+// seconds since the epoch, to the microsecond
+double
+wall_time(void);
+
+} // clang_doc
+
+#endif /* INCLUDED_UTILS_H */
@@ -0,0 +1,397 @@
+/* -*- Mode: C++ -*-
+//
+// \file: Worker_Pool.cpp
+//
+// \date: 19 Oct 2026 23:03:15 UTC
+//
+*/
+
+#include "Worker_Pool.h"
+#include "Jobserver.h"
+
+#include <deque>
+#include <errno.h>
+#include <iostream>
+#include <poll.h>
+#include <signal.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace clang_doc {
+
+namespace {
+
+bool
+write_all(int fd, const char* data, size_t len) {
+  while (len > 0) {
+    ssize_t n = write(fd, data, len);
+    if (n < 0 && errno == EINTR)
+      continue;
+    if (n <= 0)
+      return false;
+    data += n;
+    len -= n;
+  }
+  return true;
+}
+
+bool
+read_all(int fd, char* data, size_t len) {
+  while (len > 0) {
+    ssize_t n = read(fd, data, len);
+    if (n < 0 && errno == EINTR)
+      continue;
+    if (n <= 0)
+      return false;
+    data += n;
+    len -= n;
+  }
+  return true;
+}
+
+} // anonymous namespace
+
+int Worker_Pool::result_fd_ = -1;
+
+Worker_Pool::Worker_Pool(unsigned num_workers)
+  : num_workers_(num_workers ? num_workers : 1),
+    jobserver_(0) {}
+
+void
+Worker_Pool::send(unsigned type, const std::string& data) {
+  uint32_t head[2];
+  head[0] = type;
+  head[1] = data.length();
+  if (!write_all(result_fd_, reinterpret_cast<const char*>(head), sizeof(head)) ||
+      !write_all(result_fd_, data.data(), data.length()))
+    _exit(1);
+}
+
+void
+Worker_Pool::worker_main(Job& job, int task_fd) {
+  job.start();
+  while (true) {
+    uint32_t task[2];
+    if (!read_all(task_fd, reinterpret_cast<char*>(task), sizeof(task)))
+      break;
+    job.run(task[0], task[1] != 0);
+    std::cout.flush();
+    send(Msg_Done, std::string());
+  }
+  std::cout.flush();
+  _exit(0);
+}
+
+bool
+Worker_Pool::spawn(Job& job, Worker& w) {
+  int task_pipe[2];
+  int result_pipe[2];
+  if (pipe(task_pipe) != 0)
+    return false;
+  if (pipe(result_pipe) != 0) {
+    close(task_pipe[0]);
+    close(task_pipe[1]);
+    return false;
+  }
+
+  // don't let the child inherit (and later flush) buffered output
+  std::cout.flush();
+  std::cerr.flush();
+  fflush(0);
+
+  job.before_fork();
+  pid_t pid = fork();
+  if (pid != 0)
+    job.after_fork();
+  if (pid < 0) {
+    close(task_pipe[0]);
+    close(task_pipe[1]);
+    close(result_pipe[0]);
+    close(result_pipe[1]);
+    return false;
+  }
+  if (pid == 0) {
+    // only keep our own ends of our own pipes
+    for (std::vector<Worker>::iterator i = workers_.begin(),
+           e = workers_.end(); i != e; ++i) {
+      if ((*i).pid > 0) {
+        close((*i).task_fd);
+        close((*i).result_fd);
+      }
+    }
+    close(task_pipe[1]);
+    close(result_pipe[0]);
+    result_fd_ = result_pipe[1];
+    worker_main(job, task_pipe[0]);
+  }
+
+  close(task_pipe[0]);
+  close(result_pipe[1]);
+  w.pid = pid;
+  w.task_fd = task_pipe[1];
+  w.result_fd = result_pipe[0];
+  w.task = -1;
+  w.retry = false;
+  w.buffer.clear();
+  w.messages.clear();
+  return true;
+}
+
+void
+Worker_Pool::reap(Worker& w) {
+  if (w.pid <= 0)
+    return;
+  close(w.task_fd);
+  close(w.result_fd);
+  int status;
+  while (waitpid(w.pid, &status, 0) < 0 && errno == EINTR)
+    ;
+  w.pid = -1;
+}
+
+void
+Worker_Pool::replace_dead_idle(Job& job) {
+  for (std::vector<Worker>::iterator i = workers_.begin(),
+         e = workers_.end(); i != e; ++i) {
+    Worker& w = *i;
+    if (w.pid <= 0 || w.task >= 0)
+      continue;
+    int status;
+    pid_t r = waitpid(w.pid, &status, WNOHANG);
+    if (r == 0 || (r < 0 && errno == EINTR))
+      continue;
+    close(w.task_fd);
+    close(w.result_fd);
+    w.pid = -1;
+    if (!spawn(job, w))
+      std::cerr << "error: could not restart worker process\n";
+  }
+}
+
+Worker_Pool::Worker*
+Worker_Pool::idle_worker(Job& job, unsigned max_workers) {
+  for (std::vector<Worker>::iterator i = workers_.begin(),
+         e = workers_.end(); i != e; ++i) {
+    if ((*i).pid > 0 && (*i).task < 0)
+      return &*i;
+  }
+  if (workers_.size() >= max_workers)
+    return 0;
+  // there's room reserved, so the other workers don't move
+  workers_.push_back(Worker());
+  workers_.back().pid = -1;
+  if (!spawn(job, workers_.back())) {
+    std::cerr << "error: could not start worker process\n";
+    workers_.pop_back();
+    return 0;
+  }
+  return &workers_.back();
+}
+
+unsigned
+Worker_Pool::busy_workers(void) const {
+  unsigned n = 0;
+  for (std::vector<Worker>::const_iterator i = workers_.begin(),
+         e = workers_.end(); i != e; ++i) {
+    if ((*i).pid > 0 && (*i).task >= 0)
+      ++n;
+  }
+  return n;
+}
+
+void
+Worker_Pool::release_tokens(void) {
+  if (!jobserver_)
+    return;
+  // the first busy worker runs in our own job slot
+  unsigned busy = busy_workers();
+  while (jobserver_->held() > 0 && jobserver_->held() >= busy)
+    jobserver_->release();
+}
+
+void
+Worker_Pool::run(Job& job, unsigned num_tasks,
+                 std::vector<Result>& results, std::vector<bool>& failed) {
+  results.assign(num_tasks, Result());
+  failed.assign(num_tasks, false);
+  if (!num_tasks)
+    return;
+
+  // a worker dying mustn't take us with it when we next write to it
+  signal(SIGPIPE, SIG_IGN);
+
+  unsigned max_workers = num_workers_ < num_tasks ? num_workers_ : num_tasks;
+  workers_.clear();
+  workers_.reserve(max_workers);
+  // with a jobserver, workers are only started as tokens come free
+  unsigned num_workers = jobserver_ ? 1 : max_workers;
+  for (unsigned i = 0; i < num_workers; ++i) {
+    if (!idle_worker(job, max_workers))
+      break;
+  }
+  if (workers_.empty()) {
+    failed.assign(num_tasks, true);
+    return;
+  }
+
+  unsigned next = 0;
+  unsigned done = 0;
+  std::vector<bool> finished(num_tasks, false);
+  std::deque<unsigned> retries;
+  // tasks that never reached the worker they were handed to
+  std::deque<unsigned> returned;
+
+  while (done < num_tasks) {
+    replace_dead_idle(job);
+
+    // hand out work to idle workers, retries first
+    bool want_token = false;
+    while (!retries.empty() || !returned.empty() || next < num_tasks) {
+      Worker* idle = idle_worker(job, max_workers);
+      if (!idle)
+        break;
+      if (jobserver_ && busy_workers() > jobserver_->held() &&
+          !jobserver_->acquire()) {
+        want_token = true;
+        break;
+      }
+      Worker& w = *idle;
+      uint32_t task[2];
+      if (!retries.empty()) {
+        task[0] = retries.front();
+        task[1] = 1;
+        retries.pop_front();
+      }
+      else if (!returned.empty()) {
+        task[0] = returned.front();
+        task[1] = 0;
+        returned.pop_front();
+      }
+      else if (next < num_tasks) {
+        task[0] = next < order_.size() ? order_[next] : next;
+        ++next;
+        task[1] = 0;
+      }
+      w.task = task[0];
+      w.retry = task[1] != 0;
+      w.messages.clear();
+      w.buffer.clear();
+      if (!write_all(w.task_fd, reinterpret_cast<const char*>(task), sizeof(task))) {
+        // the worker died before it got the task, so the task isn't
+        // charged with the crash
+        w.task = -1;
+        reap(w);
+        if (w.retry)
+          retries.push_front(task[0]);
+        else
+          returned.push_front(task[0]);
+        if (!spawn(job, w)) {
+          std::cerr << "error: could not restart worker process\n";
+          break;
+        }
+      }
+    }
+
+    std::vector<struct pollfd> fds;
+    std::vector<Worker*> busy;
+    for (std::vector<Worker>::iterator i = workers_.begin(),
+           e = workers_.end(); i != e; ++i) {
+      if ((*i).pid > 0 && (*i).task >= 0) {
+        struct pollfd p;
+        p.fd = (*i).result_fd;
+        p.events = POLLIN;
+        p.revents = 0;
+        fds.push_back(p);
+        busy.push_back(&*i);
+      }
+    }
+    if (busy.empty()) {
+      std::cerr << "error: no worker processes left\n";
+      for (unsigned t = 0; t < num_tasks; ++t) {
+        if (!finished[t])
+          failed[t] = true;
+      }
+      break;
+    }
+    if (want_token) {
+      struct pollfd p;
+      p.fd = jobserver_->poll_fd();
+      p.events = POLLIN;
+      p.revents = 0;
+      fds.push_back(p);
+    }
+    if (poll(&fds[0], fds.size(), -1) < 0) {
+      if (errno == EINTR)
+        continue;
+      perror("poll");
+      break;
+    }
+
+    // the jobserver's fd, if polled, is last and needs nothing more
+    for (size_t n = 0; n < busy.size(); ++n) {
+      if (!fds[n].revents)
+        continue;
+      Worker& w = *busy[n];
+
+      char buf[65536];
+      ssize_t len = read(w.result_fd, buf, sizeof(buf));
+      if (len < 0 && errno == EINTR)
+        continue;
+
+      if (len <= 0) {
+        // the worker died in the middle of a task
+        unsigned task = w.task;
+        reap(w);
+        if (!w.retry) {
+          std::cerr << "error: worker crashed, retrying task " << task << "\n";
+          retries.push_back(task);
+        }
+        else {
+          failed[task] = true;
+          finished[task] = true;
+          ++done;
+        }
+        if (!spawn(job, w))
+          std::cerr << "error: could not restart worker process\n";
+        continue;
+      }
+
+      w.buffer.append(buf, len);
+      size_t pos = 0;
+      uint32_t head[2];
+      while (w.buffer.length() - pos >= sizeof(head)) {
+        memcpy(head, w.buffer.data() + pos, sizeof(head));
+        if (w.buffer.length() - pos - sizeof(head) < head[1])
+          break;
+        Message m;
+        m.type = head[0];
+        m.data.assign(w.buffer, pos + sizeof(head), head[1]);
+        pos += sizeof(head) + head[1];
+
+        if (m.type == Msg_Done) {
+          job.done(w.task, w.messages);
+          results[w.task].swap(w.messages);
+          w.messages.clear();
+          finished[w.task] = true;
+          w.task = -1;
+          ++done;
+          break;
+        }
+        w.messages.push_back(m);
+      }
+      w.buffer.erase(0, pos);
+    }
+    release_tokens();
+  }
+
+  for (std::vector<Worker>::iterator i = workers_.begin(),
+         e = workers_.end(); i != e; ++i)
+    reap(*i);
+  workers_.clear();
+  release_tokens();
+}
+
+} // clang_doc
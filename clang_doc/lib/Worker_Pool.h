@@ -0,0 +1,120 @@
+/* -*- Mode: C++ -*-
+//
+// \file: Worker_Pool.h
+//
+// \date: 19 Oct 2026 23:02:47 UTC
+//
+// A pool of pre-forked worker processes.  libclang can crash or abort on
+// odd input (or a stale .tu file), so each file is handled in a worker;
+// a worker that dies is replaced, its file is retried once, and only
+// then given up on.
+//
+// The parent hands out task numbers over one pipe per worker, and each
+// worker answers over another with framed messages,
+//
+//   uint32 type, uint32 length, length bytes
+//
+// ending each task with Msg_Done.  A task's messages are only kept once
+// its Msg_Done arrives, so a crash never leaves partial results behind.
+//
+*/
+
+#ifndef INCLUDED_WORKER_POOL_H
+#define INCLUDED_WORKER_POOL_H
+
+#include <string>
+#include <sys/types.h>
+#include <vector>
+
+namespace clang_doc {
+
+class Jobserver;
+
+class Worker_Pool {
+public:
+  enum Message_Type {
+    Msg_Def,     // definitions found in the file
+    Msg_Page,    // 'r' if relinked, output filename, NUL, page contents;
+                 // or 'c' if created, output filename, NUL, the temporary
+                 // file holding the page
+    Msg_Xref,    // Xref_Index::serialize()
+    Msg_Diag,    // Diagnostic_Store::serialize()
+    Msg_Cost,    // "seconds tokens" the task took, for the Cost_Model
+    Msg_Done     // end of the task
+  };
+
+  struct Message {
+    unsigned type;
+    std::string data;
+  };
+  typedef std::vector<Message> Result;
+
+  // does the work for each task, in a worker process
+  class Job {
+  public:
+    virtual ~Job(void) {}
+    // called once in each new worker
+    virtual void start(void) {}
+    // retry is true if the task already crashed a worker once
+    virtual void run(unsigned task, bool retry) = 0;
+    // called in the parent as each task completes, before its messages
+    // are stored in the results; it may consume some of them
+    virtual void done(unsigned, Result&) {}
+    // called in the parent around each fork, e.g. to hold threads that
+    // could be holding a lock the new worker will need
+    virtual void before_fork(void) {}
+    virtual void after_fork(void) {}
+  };
+
+  explicit Worker_Pool(unsigned num_workers);
+
+  // hand tasks out in this order rather than 0, 1, 2, ...
+  void set_order(const std::vector<unsigned>& order) {order_ = order;}
+
+  // only run more than one task at a time while holding a token from
+  // jobserver for each extra one
+  void set_jobserver(Jobserver* jobserver) {jobserver_ = jobserver;}
+
+  // run tasks [0, num_tasks) in the workers.  results[task] holds the
+  // messages the task sent, and failed[task] is set if it crashed a
+  // worker twice.
+  void run(Job& job, unsigned num_tasks,
+           std::vector<Result>& results, std::vector<bool>& failed);
+
+  // send a message to the parent; only call from Job::run()
+  static void send(unsigned type, const std::string& data);
+
+private:
+  struct Worker {
+    pid_t pid;
+    int task_fd;
+    int result_fd;
+    int task;     // -1 when idle
+    bool retry;
+    std::string buffer;
+    Result messages;
+  };
+
+  bool spawn(Job& job, Worker& w);
+  void worker_main(Job& job, int task_fd);
+  void reap(Worker& w);
+  // replace idle workers that died between tasks, before one is handed a
+  // task and its death is taken for a crash on that task
+  void replace_dead_idle(Job& job);
+  // an idle worker, started if need be; 0 if there's none to be had
+  Worker* idle_worker(Job& job, unsigned max_workers);
+  unsigned busy_workers(void) const;
+  // give back tokens the busy workers no longer need
+  void release_tokens(void);
+
+  unsigned num_workers_;
+  std::vector<unsigned> order_;
+  Jobserver* jobserver_;
+  std::vector<Worker> workers_;
+
+  static int result_fd_;
+};
+
+} // clang_doc
+
+#endif /* INCLUDED_WORKER_POOL_H */
@@ -0,0 +1,482 @@
+/* -*- Mode: C++ -*-
+//
+// \file: Xref_Index.cpp
+//
+// \date: 19 Oct 2026 09:12:51 UTC
+//
+*/
+
+#include "Xref_Index.h"
+#include "Html_File.h"
+#include "Output_Writer.h"
+#include "Utils.h"
+
+#include <algorithm>
+#include <iostream>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace clang_doc {
+
+namespace {
+
+const char xref_magic[8] = {'C', 'D', 'X', 'R', 'E', 'F', '0', '1'};
+const uint32_t xref_block_size = 64;
+
+void
+put_varint(std::string& out, uint64_t v) {
+  while (v >= 0x80) {
+    out.push_back(static_cast<char>((v & 0x7f) | 0x80));
+    v >>= 7;
+  }
+  out.push_back(static_cast<char>(v));
+}
+
+// false, leaving p alone, if the varint runs past end
+bool
+get_varint(const char*& p, const char* end, uint64_t& v) {
+  v = 0;
+  unsigned shift = 0;
+  for (const char* q = p; q != end && shift < 64; shift += 7) {
+    unsigned char c = static_cast<unsigned char>(*q++);
+    v |= static_cast<uint64_t>(c & 0x7f) << shift;
+    if (!(c & 0x80)) {
+      p = q;
+      return true;
+    }
+  }
+  return false;
+}
+
+size_t
+shared_prefix(const std::string& a, const std::string& b) {
+  size_t n = std::min(a.length(), b.length());
+  size_t i = 0;
+  while (i < n && a[i] == b[i]) ++i;
+  return i;
+}
+
+void
+write_escaped(FILE* f, const std::string& s) {
+  for (std::string::const_iterator i = s.begin(), e = s.end(); i != e; ++i) {
+    switch (*i) {
+    case ('<'): fputs("&lt;", f); break;
+    case ('>'): fputs("&gt;", f); break;
+    case ('&'): fputs("&amp;", f); break;
+    case ('"'): fputs("&quot;", f); break;
+    default: fputc(*i, f); break;
+    }
+  }
+}
+
+} // anonymous namespace
+
+struct Xref_Index::Use_Less {
+  Use_Less(const std::vector<std::string>& keys,
+           const std::vector<std::string>& files)
+    : keys_(keys), files_(files) {}
+
+  bool operator()(const Use& a, const Use& b) const {
+    if (a.key != b.key)
+      return keys_[a.key] < keys_[b.key];
+    if (a.file != b.file)
+      return files_[a.file] < files_[b.file];
+    return a.line < b.line;
+  }
+
+  const std::vector<std::string>& keys_;
+  const std::vector<std::string>& files_;
+};
+
+Xref_Index::Xref_Index(void)
+  : sorted_(true) {}
+
+unsigned
+Xref_Index::intern(std::map<std::string, unsigned>& ids,
+                   std::vector<std::string>& names,
+                   const std::string& str) {
+  std::map<std::string, unsigned>::iterator i = ids.find(str);
+  if (i != ids.end())
+    return i->second;
+  unsigned id = names.size();
+  names.push_back(str);
+  ids.insert(std::pair<std::string, unsigned>(str, id));
+  return id;
+}
+
+// one "line<TAB>file<TAB>key" line per use
+void
+Xref_Index::serialize(std::string& out) const {
+  for (std::vector<Use>::const_iterator i = uses_.begin(),
+         e = uses_.end(); i != e; ++i) {
+    char line[32];
+    snprintf(line, sizeof(line), "%u\t", (*i).line);
+    out += line;
+    out += files_[(*i).file];
+    out += '\t';
+    out += keys_[(*i).key];
+    out += '\n';
+  }
+}
+
+bool
+Xref_Index::merge(const std::string& data) {
+  size_t pos = 0;
+  while (pos < data.length()) {
+    size_t tab1 = data.find('\t', pos);
+    size_t tab2 = tab1 == std::string::npos ? tab1 : data.find('\t', tab1 + 1);
+    size_t nl = tab2 == std::string::npos ? tab2 : data.find('\n', tab2 + 1);
+    if (nl == std::string::npos)
+      return false;
+    unsigned line = strtoul(data.c_str() + pos, 0, 10);
+    add(data.substr(tab2 + 1, nl - tab2 - 1), data.substr(tab1 + 1, tab2 - tab1 - 1), line);
+    pos = nl + 1;
+  }
+  return true;
+}
+
+void
+Xref_Index::add(const std::string& key, const std::string& file, unsigned line) {
+  Use u;
+  u.key = intern(key_ids_, keys_, key);
+  u.file = intern(file_ids_, files_, file);
+  u.line = line;
+  uses_.push_back(u);
+  sorted_ = false;
+}
+
+void
+Xref_Index::sort(void) {
+  if (sorted_)
+    return;
+  std::sort(uses_.begin(), uses_.end(), Use_Less(keys_, files_));
+
+  // several uses on the same line only need to be listed once
+  std::vector<Use>::iterator out = uses_.begin();
+  for (std::vector<Use>::iterator i = uses_.begin(), e = uses_.end();
+       i != e; ++i) {
+    if (out != uses_.begin()) {
+      const Use& prev = *(out - 1);
+      if (prev.key == i->key && prev.file == i->file && prev.line == i->line)
+        continue;
+    }
+    *out++ = *i;
+  }
+  uses_.erase(out, uses_.end());
+  sorted_ = true;
+}
+
+bool
+Xref_Index::write(const std::string& filename) {
+  sort();
+
+  char* buf = 0;
+  size_t len = 0;
+  FILE* f = open_memstream(&buf, &len);
+  if (!f) {
+    std::cerr << "error creating xref file: " << filename.c_str() << "\n";
+    return false;
+  }
+
+  Xref_Header header;
+  memset(&header, 0, sizeof(header));
+  memcpy(header.magic, xref_magic, sizeof(header.magic));
+  header.block_size = xref_block_size;
+  header.num_files = files_.size();
+  header.num_uses = uses_.size();
+
+  // placeholder, rewritten once all offsets are known
+  fwrite(&header, sizeof(header), 1, f);
+  uint64_t offset = sizeof(header);
+
+  header.files_offset = offset;
+  for (std::vector<std::string>::const_iterator i = files_.begin(),
+         e = files_.end(); i != e; ++i) {
+    fwrite((*i).c_str(), (*i).length() + 1, 1, f);
+    offset += (*i).length() + 1;
+  }
+
+  std::vector<Xref_Block_Entry> index;
+  std::string keys;
+  std::string block;
+  std::string prev;
+  for (size_t i = 0; i < uses_.size(); ++i) {
+    const Use& u = uses_[i];
+    const std::string& key = keys_[u.key];
+
+    if (i % xref_block_size == 0) {
+      fwrite(block.data(), block.length(), 1, f);
+      offset += block.length();
+      block.clear();
+
+      Xref_Block_Entry entry;
+      entry.offset = offset;
+      entry.key_offset = keys.length();
+      entry.key_length = key.length();
+      entry.num_uses = std::min<uint64_t>(xref_block_size, uses_.size() - i);
+      index.push_back(entry);
+      keys += key;
+      prev.clear();
+    }
+
+    size_t shared = shared_prefix(prev, key);
+    put_varint(block, shared);
+    put_varint(block, key.length() - shared);
+    block.append(key, shared, std::string::npos);
+    put_varint(block, u.file);
+    put_varint(block, u.line);
+    prev = key;
+  }
+  fwrite(block.data(), block.length(), 1, f);
+  offset += block.length();
+
+  static const char pad[8] = {0};
+  size_t padding = (8 - offset % 8) % 8;
+  fwrite(pad, padding, 1, f);
+  offset += padding;
+
+  header.num_blocks = index.size();
+  header.index_offset = offset;
+  if (!index.empty())
+    fwrite(&index[0], sizeof(Xref_Block_Entry), index.size(), f);
+  offset += sizeof(Xref_Block_Entry) * index.size();
+
+  header.keys_offset = offset;
+  fwrite(keys.data(), keys.length(), 1, f);
+
+  bool ok = !ferror(f);
+  if (fclose(f) != 0)
+    ok = false;
+  if (ok) {
+    memcpy(buf, &header, sizeof(header));
+    // an unchanged index leaves the pages built from it alone
+    ok = Output_Writer().write_if_changed(filename, buf, len);
+  }
+  else
+    std::cerr << "error writing xref file: " << filename.c_str() << "\n";
+  free(buf);
+  return ok;
+}
+
+void
+Xref_Index::write_html(const std::map<std::string, Definition>& defmap,
+                       const std::string& html_dir,
+                       const std::string& prefix,
+                       Layout layout) {
+  sort();
+  // the references page sits next to the source page, in its shard
+  const char* root = root_prefix(layout);
+
+  // group the local definitions by the file that defines them
+  typedef std::map<std::string, std::vector<const Definition*> > File_Defs;
+  File_Defs file_defs;
+  for (std::map<std::string, Definition>::const_iterator i = defmap.begin(),
+         e = defmap.end(); i != e; ++i) {
+    if (!i->second.from_tag_file)
+      file_defs[i->second.file].push_back(&i->second);
+  }
+
+  Output_Writer output;
+  for (File_Defs::const_iterator i = file_defs.begin(),
+         e = file_defs.end(); i != e; ++i) {
+    std::string filename = make_filename(i->first, html_dir, prefix, ".refs.html",
+                                         true, layout);
+    char* buf = 0;
+    size_t len = 0;
+    FILE* f = open_memstream(&buf, &len);
+    if (!f) {
+      std::cerr << "error: could not create file: " << filename.c_str() << "\n";
+      continue;
+    }
+    std::string page = root + make_filename(i->first, html_dir, prefix, ".html",
+                                            false, layout);
+
+    fprintf (f, "<html><head>\n");
+    fprintf (f, "<meta http-equiv=\"Content-Type\" content=\"text/html;charset=iso-8859-1\"/>");
+    fprintf (f, "<title>clang: %s References</title>", i->first.c_str());
+    fprintf (f, "<link href=\"%sdoxygen.css\" rel=\"stylesheet\" type=\"text/css\"/>", root);
+    fprintf (f, "</head><body>");
+    fprintf (f, "<p class=\"title\">clang Code Documentation</p>");
+    fprintf (f, "<div class=\"contents\">");
+    fprintf (f, "<h1>References to definitions in <a class=\"code\" href=\"%s\">%s</a></h1>",
+             page.c_str(), i->first.c_str());
+
+    for (std::vector<const Definition*>::const_iterator di = i->second.begin(),
+           de = i->second.end(); di != de; ++di) {
+      const Definition* d = *di;
+
+      // uses are sorted by key, so find the range for this one
+      size_t lo = 0;
+      size_t hi = uses_.size();
+      while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        if (keys_[uses_[mid].key] < d->key)
+          lo = mid + 1;
+        else
+          hi = mid;
+      }
+
+      fprintf (f, "<h3><a class=\"code\" name=\"");
+      write_escaped(f, d->key);
+      fprintf (f, "\" href=\"%s#l%05i\">", page.c_str(), d->line);
+      write_escaped(f, d->key);
+      fprintf (f, "</a></h3><ul>");
+      for (size_t u = lo; u < uses_.size() && keys_[uses_[u].key] == d->key; ++u) {
+        const std::string& file = files_[uses_[u].file];
+        std::string href = root + make_filename(file, html_dir, prefix, ".html",
+                                                false, layout);
+        fprintf (f, "<li><a class=\"code\" href=\"%s#l%05i\">%s:%u</a></li>",
+                 href.c_str(), uses_[u].line, file.c_str(), uses_[u].line);
+      }
+      fprintf (f, "</ul>");
+    }
+
+    fprintf (f, "</div></body></html>");
+    fclose(f);
+    output.write_if_changed(filename, buf, len);
+    free(buf);
+  }
+}
+
+Xref_Reader::Xref_Reader(void)
+  : map_(0),
+    size_(0),
+    header_(0),
+    index_(0) {}
+
+Xref_Reader::~Xref_Reader(void) {
+  close();
+}
+
+bool
+Xref_Reader::open(const std::string& filename) {
+  close();
+
+  int fd = ::open(filename.c_str(), O_RDONLY);
+  if (fd < 0)
+    return false;
+
+  struct stat st;
+  if (fstat(fd, &st) != 0 || st.st_size < (off_t)sizeof(Xref_Header)) {
+    ::close(fd);
+    return false;
+  }
+
+  void* p = mmap(0, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+  ::close(fd);
+  if (p == MAP_FAILED)
+    return false;
+
+  map_ = static_cast<const char*>(p);
+  size_ = st.st_size;
+  header_ = reinterpret_cast<const Xref_Header*>(map_);
+
+  // everything the header points at must lie inside the file, so a
+  // truncated or corrupt index is rejected here rather than read past
+  const Xref_Header& h = *header_;
+  if (memcmp(h.magic, xref_magic, sizeof(xref_magic)) != 0 ||
+      h.files_offset < sizeof(Xref_Header) || h.files_offset > size_ ||
+      h.index_offset > size_ || h.index_offset % 8 != 0 ||
+      h.num_blocks > (size_ - h.index_offset) / sizeof(Xref_Block_Entry) ||
+      h.keys_offset > size_ ||
+      h.keys_offset < h.index_offset + h.num_blocks * sizeof(Xref_Block_Entry)) {
+    close();
+    return false;
+  }
+  index_ = reinterpret_cast<const Xref_Block_Entry*>(map_ + h.index_offset);
+  for (uint64_t b = 0; b < h.num_blocks; ++b) {
+    const Xref_Block_Entry& entry = index_[b];
+    if (entry.offset < h.files_offset || entry.offset > h.index_offset ||
+        entry.key_offset > size_ - h.keys_offset ||
+        entry.key_length > size_ - h.keys_offset - entry.key_offset) {
+      close();
+      return false;
+    }
+  }
+
+  const char* s = map_ + h.files_offset;
+  const char* end = map_ + h.index_offset;
+  for (uint32_t i = 0; i < h.num_files; ++i) {
+    const char* nul = s < end ? static_cast<const char*>(memchr(s, 0, end - s)) : 0;
+    if (!nul) {
+      close();
+      return false;
+    }
+    files_.push_back(s);
+    s = nul + 1;
+  }
+  return true;
+}
+
+void
+Xref_Reader::close(void) {
+  if (map_)
+    munmap(const_cast<char*>(map_), size_);
+  map_ = 0;
+  size_ = 0;
+  header_ = 0;
+  index_ = 0;
+  files_.clear();
+}
+
+void
+Xref_Reader::find(const std::string& key,
+                  std::vector<Xref_Location>& uses) const {
+  if (!map_ || header_->num_blocks == 0)
+    return;
+
+  // find the first block whose first key is >= key; the key may also
+  // start in the block before it.
+  const char* keys = map_ + header_->keys_offset;
+  uint64_t lo = 0;
+  uint64_t hi = header_->num_blocks;
+  while (lo < hi) {
+    uint64_t mid = lo + (hi - lo) / 2;
+    const Xref_Block_Entry& entry = index_[mid];
+    if (std::string(keys + entry.key_offset, entry.key_length) < key)
+      lo = mid + 1;
+    else
+      hi = mid;
+  }
+  if (lo > 0)
+    --lo;
+
+  // blocks end where the block index starts
+  const char* end = map_ + header_->index_offset;
+  std::string cur;
+  for (uint64_t b = lo; b < header_->num_blocks; ++b) {
+    const Xref_Block_Entry& entry = index_[b];
+    const char* p = map_ + entry.offset;
+    for (uint32_t i = 0; i < entry.num_uses; ++i) {
+      uint64_t shared;
+      uint64_t length;
+      uint64_t file;
+      uint64_t line;
+      if (!get_varint(p, end, shared) || !get_varint(p, end, length) ||
+          shared > cur.length() || length > static_cast<uint64_t>(end - p))
+        return;
+      cur.resize(shared);
+      cur.append(p, length);
+      p += length;
+      if (!get_varint(p, end, file) || !get_varint(p, end, line))
+        return;
+
+      int cmp = cur.compare(key);
+      if (cmp > 0)
+        return;
+      if (cmp == 0 && file < files_.size()) {
+        Xref_Location loc;
+        loc.file = files_[file];
+        loc.line = line;
+        uses.push_back(loc);
+      }
+    }
+  }
+}
+
+} // clang_doc
@@ -0,0 +1,130 @@
+/* -*- Mode: C++ -*-
+//
+// \file: Xref_Index.h
+//
+// \date: 19 Oct 2026 09:12:40 UTC
+//
+// Cross-reference (find-uses) index.  Html_File records every resolved
+// reference while it renders a page, and Clang_Doc writes the collected
+// records out as an inverted index keyed by definition.
+//
+// On-disk format (native byte order, designed to be mmap'ed):
+//
+//   Xref_Header
+//   file table:   num_files NUL terminated source file names
+//   data blocks:  uses sorted by (key, file, line), block_size uses per
+//                 block.  Each use is encoded as
+//                   varint shared   -- bytes shared with previous key
+//                   varint length   -- length of the key suffix
+//                   bytes  suffix
+//                   varint file     -- index into the file table
+//                   varint line
+//                 The first use in a block always has shared == 0.
+//   block index:  num_blocks Xref_Block_Entry, 8 byte aligned
+//   key pool:     first key of each block, referenced by the block index
+//
+*/
+
+#ifndef INCLUDED_XREF_INDEX_H
+#define INCLUDED_XREF_INDEX_H
+
+#include "Utils.h"
+
+#include <map>
+#include <string>
+#include <vector>
+#include <stdint.h>
+
+namespace clang_doc {
+
+struct Definition;
+
+struct Xref_Header {
+  char magic[8];
+  uint32_t block_size;
+  uint32_t num_files;
+  uint64_t num_uses;
+  uint64_t num_blocks;
+  uint64_t files_offset;
+  uint64_t index_offset;
+  uint64_t keys_offset;
+};
+
+struct Xref_Block_Entry {
+  uint64_t offset;
+  uint64_t key_offset;
+  uint32_t key_length;
+  uint32_t num_uses;
+};
+
+struct Xref_Location {
+  std::string file;
+  unsigned line;
+};
+
+class Xref_Index {
+public:
+  Xref_Index(void);
+
+  void add(const std::string& key, const std::string& file, unsigned line);
+  size_t size(void) const {return uses_.size();}
+
+  bool write(const std::string& filename);
+
+  // pass uses between processes: serialize() in one, merge() the result
+  // into another
+  void serialize(std::string& out) const;
+  bool merge(const std::string& data);
+
+  // generate a "referenced from" page for each source file that
+  // contains local definitions.
+  void write_html(const std::map<std::string, Definition>& defmap,
+                  const std::string& html_dir,
+                  const std::string& prefix,
+                  Layout layout = Layout_Flat);
+
+private:
+  struct Use {
+    unsigned key;
+    unsigned file;
+    unsigned line;
+  };
+  struct Use_Less;
+
+  unsigned intern(std::map<std::string, unsigned>& ids,
+                  std::vector<std::string>& names,
+                  const std::string& str);
+  void sort(void);
+
+  std::map<std::string, unsigned> key_ids_;
+  std::vector<std::string> keys_;
+  std::map<std::string, unsigned> file_ids_;
+  std::vector<std::string> files_;
+  std::vector<Use> uses_;
+  bool sorted_;
+};
+
+class Xref_Reader {
+public:
+  Xref_Reader(void);
+  ~Xref_Reader(void);
+
+  bool open(const std::string& filename);
+  void close(void);
+
+  void find(const std::string& key, std::vector<Xref_Location>& uses) const;
+
+private:
+  Xref_Reader(const Xref_Reader&);
+  Xref_Reader& operator=(const Xref_Reader&);
+
+  const char* map_;
+  size_t size_;
+  const Xref_Header* header_;
+  const Xref_Block_Entry* index_;
+  std::vector<const char*> files_;
+};
+
+} // clang_doc
+
+#endif /* INCLUDED_XREF_INDEX_H */
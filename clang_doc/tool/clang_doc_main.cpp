@@ -0,0 +1,369 @@
+/* -*- Mode: C++ -*-
+//
+// \file: clang_doc_main.cpp
+//
+// \author: Don Allon Hinton <don.hinton@gmx.com>
+// \date: 13 Aug 2012 14:33:27 UTC
+//
+*/
+
+#include "Clang_Doc.h"
+#include "Renderer.h"
+#include "Symbol_Table.h"
+#include "Xref_Index.h"
+#include <getopt.h>
+#include <iostream>
+#include <iterator>
+#include <set>
+#include <sys/param.h>
+#include <stdlib.h>
+#include <string.h>
+
+namespace {
+
+short g_debug = 0;
+std::string g_root_dir = "";
+std::string g_html_dir = "html";
+std::string g_object_dir = ".obj";
+std::string g_file;
+std::string g_tag_out;
+std::string g_xref;
+std::string g_uses;
+std::string g_render;
+unsigned short g_serve_port = 0;
+size_t g_cache_mb = 64;
+std::string g_diag_file;
+CXDiagnosticSeverity g_diag_level = CXDiagnostic_Note;
+clang_doc::Output_Format g_format = clang_doc::Format_Html;
+bool g_gzip = false;
+clang_doc::Layout g_layout = clang_doc::Layout_Flat;
+std::string g_symtab_dir;
+bool g_relink = false;
+// 0 until -j is given
+unsigned g_jobs = 0;
+unsigned g_writers = 2;
+unsigned g_write_queue = 32;
+std::set<std::string> g_tags;
+
+
+void usage(void) {
+
+  printf("usage: clang_doc [clang_doc Options] -- [clang Options]\n\n");
+  printf("Options:\n\n");
+  printf("  -h, --help             this screen\n");
+  printf("  -d, --debug            enable debugging output\n");
+  printf("  -R, --root_dir=arg     root directory (this path is trimmed from input files\n");
+  printf("                         when generating html filenames)\n");
+  printf("  -D, --html_dir=arg     html output directory (default: html) -- it must exist\n");
+  printf("  -O, --object_dir=arg   location to store translation unit objects (they only\n");
+  printf("                         get regenerated if the underlying source changes.\n");
+  printf("                         (default .obj) -- it must exist\n");
+  printf("  -t, --tag_in=arg       input tag file(s) -- can provide multiple\n");
+  printf("  -T, --tag_out=arg      out tag file\n");
+  printf("  -S, --symtab_dir=arg   share the symbol tables read from tag files with other\n");
+  printf("                         clang_doc processes through read-only images in arg\n");
+  printf("  -x, --xref=arg         write a cross-reference (find uses) index to arg, and\n");
+  printf("                         generate \"referenced from\" pages in the html directory\n");
+  printf("  -u, --uses=arg         print the uses of symbol arg recorded in the --xref\n");
+  printf("                         index, one file:line per line, and exit\n");
+  printf("  -f, --file=arg         input file (if not provided, read from stdin)\n");
+  printf("  -s, --serve=port       build the symbol table, then serve pages from a local\n");
+  printf("                         http server, rendering each one when it is requested\n");
+  printf("  -p, --render=arg       render the page for source file arg from the text on\n");
+  printf("                         stdin, and write it to stdout; the html and object\n");
+  printf("                         directories are not used\n");
+  printf("  -c, --cache_mb=arg     size of the --serve page cache in MB (default 64)\n");
+  printf("  -E, --diag_file=arg    also write the collected diagnostics to arg as json\n");
+  printf("  -L, --diag_level=arg   minimum diagnostic level to report: note, warning or\n");
+  printf("                         error (default note)\n");
+  printf("  -F, --format=arg       page format: html, or stream for a compact token stream\n");
+  printf("                         that clang_doc.js renders in the browser (default html)\n");
+  printf("  -l, --layout=arg       flat, to put every page and object file straight in\n");
+  printf("                         the html and object directories, or hashed, to\n");
+  printf("                         spread them over 256 subdirectories (default flat)\n");
+  printf("  -j, --jobs=arg         parse and render in arg worker processes; a file that\n");
+  printf("                         crashes a worker is retried once, then skipped.\n");
+  printf("                         under make -j, workers share make's job slots, and\n");
+  printf("                         default to one per cpu; otherwise the default is 1\n");
+  printf("  -W, --writers=arg      write pages on arg threads, so rendering doesn't wait\n");
+  printf("                         on the disk; 0 writes them as they're rendered\n");
+  printf("                         (default 2)\n");
+  printf("  -Q, --write_queue=arg  pages that may wait for the writers before rendering\n");
+  printf("                         blocks (default 32)\n");
+  printf("  -r, --relink           reuse the definitions and rendered pages cached in the\n");
+  printf("                         object directory for sources that haven't changed, and\n");
+  printf("                         only resolve their links again, without parsing\n");
+  printf("  -z, --gzip             write each page as a gzip compressed .html.gz, for\n");
+  printf("                         servers that send precompressed files (e.g., nginx\n");
+  printf("                         gzip_static)\n\n");
+  printf("Example:\n\n");
+  printf("  find libclang -name \"*.h\" -or -name \"*.cpp\" | clang_doc -- -I ../../../include\n\n");
+  printf("The html files use the llvm version of doxygen.css located in llvm/docs/.\n");
+  printf("Please copy it to the html directory.\n\n");
+
+}
+
+int parse (int& argc, char**& argv) {
+  int c;
+
+  int option_index = 0;
+  struct option long_options[] = {
+    {"help", no_argument, 0, 'h'},
+    {"debug", no_argument, 0, 'd'},
+    {"root_dir", required_argument, 0, 'R'},
+    {"html_dir", required_argument, 0, 'D'},
+    {"object_dir", required_argument, 0, 'O'},
+    {"tag_in", required_argument, 0, 't'},
+    {"tag_out", required_argument, 0, 'T'},
+    {"symtab_dir", required_argument, 0, 'S'},
+    {"xref", required_argument, 0, 'x'},
+    {"uses", required_argument, 0, 'u'},
+    {"file", required_argument, 0, 'f'},
+    {"serve", required_argument, 0, 's'},
+    {"render", required_argument, 0, 'p'},
+    {"cache_mb", required_argument, 0, 'c'},
+    {"diag_file", required_argument, 0, 'E'},
+    {"diag_level", required_argument, 0, 'L'},
+    {"format", required_argument, 0, 'F'},
+    {"layout", required_argument, 0, 'l'},
+    {"gzip", no_argument, 0, 'z'},
+    {"relink", no_argument, 0, 'r'},
+    {"jobs", required_argument, 0, 'j'},
+    {"writers", required_argument, 0, 'W'},
+    {"write_queue", required_argument, 0, 'Q'},
+    {0, 0, 0, 0}
+  };
+
+  while (1) {
+    char path[1024];
+    c = getopt_long (argc, argv, "+:dR:D:O:f:t:T:S:x:u:s:p:c:E:L:F:l:zrj:W:Q:h", long_options, &option_index);
+
+    if (c == -1)
+      break;
+
+    switch (c) {
+    case 'd':
+      g_debug = 1;
+      break;
+    case 'R':
+      g_root_dir = realpath(optarg, path);
+      break;
+    case 'D':
+      g_html_dir = realpath(optarg, path);
+      break;
+    case 'O':
+      g_object_dir = realpath(optarg, path);
+      break;
+    case 'f':
+      g_file = realpath(optarg, path);
+      break;
+    case 't':
+      g_tags.insert (optarg);
+      break;
+    case 'T':
+      g_tag_out = optarg;
+      break;
+    case 'S':
+      g_symtab_dir = realpath(optarg, path);
+      break;
+    case 'x':
+      g_xref = optarg;
+      break;
+    case 'u':
+      g_uses = optarg;
+      break;
+    case 's':
+      g_serve_port = atoi(optarg);
+      break;
+    case 'p':
+      // the file needn't exist, so it isn't resolved
+      g_render = optarg;
+      break;
+    case 'c':
+      g_cache_mb = atoi(optarg);
+      break;
+    case 'E':
+      g_diag_file = optarg;
+      break;
+    case 'L':
+      if (strcmp(optarg, "note") == 0)
+        g_diag_level = CXDiagnostic_Note;
+      else if (strcmp(optarg, "warning") == 0)
+        g_diag_level = CXDiagnostic_Warning;
+      else if (strcmp(optarg, "error") == 0)
+        g_diag_level = CXDiagnostic_Error;
+      else {
+        usage();
+        return 1;
+      }
+      break;
+    case 'F':
+      if (strcmp(optarg, "html") == 0)
+        g_format = clang_doc::Format_Html;
+      else if (strcmp(optarg, "stream") == 0)
+        g_format = clang_doc::Format_Token_Stream;
+      else {
+        usage();
+        return 1;
+      }
+      break;
+    case 'l':
+      if (strcmp(optarg, "flat") == 0)
+        g_layout = clang_doc::Layout_Flat;
+      else if (strcmp(optarg, "hashed") == 0)
+        g_layout = clang_doc::Layout_Hashed;
+      else {
+        usage();
+        return 1;
+      }
+      break;
+    case 'z':
+      g_gzip = true;
+      break;
+    case 'r':
+      g_relink = true;
+      break;
+    case 'j':
+      g_jobs = atoi(optarg);
+      if (!g_jobs)
+        g_jobs = 1;
+      break;
+    case 'W':
+      g_writers = atoi(optarg);
+      break;
+    case 'Q':
+      g_write_queue = atoi(optarg);
+      break;
+    case '?':
+    case 'h':
+      usage();
+      return 1;
+    default:
+      // ignore unknown options
+      break;
+    }
+  }
+
+  argc -= optind;
+  argv += optind;
+
+  return 0;
+}
+
+// --render: one page through the Renderer, linked against the tag files
+int render (int argc, char* argv[]) {
+  std::string text((std::istreambuf_iterator<char>(std::cin)),
+                   std::istreambuf_iterator<char>());
+
+  clang_doc::Symbol_Table symbols;
+  if (!g_symtab_dir.empty())
+    symbols.set_image_dir (g_symtab_dir);
+  for (std::set<std::string>::const_iterator i = g_tags.begin(),
+         e = g_tags.end(); i != e; ++i) {
+    if (!symbols.add_tag_file (*i))
+      std::cerr << "error: could not read tag file: " << (*i).c_str() << "\n";
+  }
+  symbols.freeze (g_root_dir, g_layout);
+
+  CXUnsavedFile unsaved;
+  unsaved.Filename = g_render.c_str();
+  unsaved.Contents = text.data();
+  unsaved.Length = text.length();
+
+  clang_doc::Renderer renderer (argc, argv, symbols, g_root_dir);
+  renderer.set_format (g_format);
+  renderer.set_layout (g_layout);
+  std::string page;
+  if (!renderer.render (g_render, &unsaved, 1, page)) {
+    std::cerr << "error: could not render file: " << g_render.c_str() << "\n";
+    return 1;
+  }
+  fwrite (page.data(), 1, page.length(), stdout);
+  return 0;
+}
+
+// --uses: look a symbol up in an index written by an earlier --xref run
+int uses (void) {
+  clang_doc::Xref_Reader reader;
+  if (g_xref.empty() || !reader.open (g_xref)) {
+    std::cerr << "error: could not read xref index: " << g_xref.c_str() << "\n";
+    return 1;
+  }
+  std::vector<clang_doc::Xref_Location> locations;
+  reader.find (g_uses, locations);
+  for (std::vector<clang_doc::Xref_Location>::const_iterator i = locations.begin(),
+         e = locations.end(); i != e; ++i)
+    std::cout << (*i).file.c_str() << ":" << (*i).line << "\n";
+  return 0;
+}
+
+} // annonymous namespace
+
+int
+main (int argc , char *argv[]) {
+  if (parse (argc, argv) != 0)
+    return 1;
+
+  if (!g_uses.empty())
+    return uses ();
+  if (!g_render.empty())
+    return render (argc, argv);
+
+  std::cout << "file:       " << g_file.c_str() << "\n";
+  std::cout << "root_dir:   " << g_root_dir.c_str() << "\n";
+  std::cout << "html_dir:   " << g_html_dir.c_str() << "\n";
+  std::cout << "object_dir: " << g_object_dir.c_str() << "\n";
+
+  std::cout << "\nremaining commandline args:\n";
+  for (int i = 0; i < argc; ++i)
+    std::cout << argv[i] << " ";
+  std::cout << "\n";
+
+  std::set<std::string> files;
+  if (g_file.empty()) {
+    std::string line;
+    while (true) {
+      std::getline(std::cin, line);
+      if (line.empty())
+        break;
+      char path[1024];
+      files.insert(realpath(line.c_str(), path));
+    }
+  }
+  else
+    files.insert(g_file);
+
+  // make sure we don't read our own tag file
+  files.erase(g_tag_out);
+
+#if 0
+  std::cout << "\ninput files:\n";
+  for (std::set<std::string>::const_iterator i = files.begin(), e = files.end();
+       i != e; ++i) {
+    std::cout << (*i).c_str() << "\n";
+  }
+#endif
+
+  clang_doc::Clang_Doc doc(argc, argv, files, g_object_dir, g_html_dir, g_root_dir);
+
+  doc.set_xref_file (g_xref);
+  doc.set_format (g_format);
+  doc.set_gzip (g_gzip);
+  doc.set_layout (g_layout);
+  doc.set_symtab_dir (g_symtab_dir);
+  doc.set_relink (g_relink);
+  doc.set_jobs (g_jobs);
+  doc.set_writers (g_writers, g_write_queue);
+  doc.diagnostics().set_min_severity (g_diag_level);
+  doc.generate_symbol_table (g_tags);
+  if (g_serve_port) {
+    doc.report_diagnostics (g_diag_file);
+    return doc.serve (g_serve_port, g_cache_mb << 20);
+  }
+  doc.generate_html_files (g_tag_out);
+  doc.report_diagnostics (g_diag_file);
+
+  std::cout << "\ndone...\n";
+
+  return 0;
+}
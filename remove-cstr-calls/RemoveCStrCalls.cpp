@@ -11,7 +11,7 @@
 //  calls of c_str() on strings.
 //
 //  Usage:
-//  remove-cstr-calls <cmake-output-dir> <file1> <file2> ...
+//  remove-cstr-calls [-j <jobs>] <cmake-output-dir> <file1> <file2> ...
 //
 //  Where <cmake-output-dir> is a CMake build directory in which a file named
 //  compile_commands.json exists (enable -DCMAKE_EXPORT_COMPILE_COMMANDS in
@@ -32,13 +32,44 @@
 //    /path/in/subtree $ find . -name '*.cpp'|
 //        xargs remove-cstr-calls /path/to/build
 //
+//  Each file is written as soon as no file still to be parsed can edit it,
+//  so memory does not grow with the run; see checks/ReplacementWriter.h.
+//  An edit to a header seen from many files is made once, and conflicting
+//  edits are reported with the files they came from.
+//
+//  With -j, <jobs> files are parsed at once, each thread with its own
+//  MatchFinder.  Only files compiled in the same directory are parsed at
+//  once.  The result does not depend on the number of jobs.
+//
+//  With -pch-dir, the #includes at the top of files compiled with the same
+//  command are precompiled once into <dir>, and the files are parsed with
+//  the PCH; see checks/PchCompilationDatabase.h.
+//
+//  With -prefilter, files that don't contain the identifier c_str are
+//  skipped without being parsed; -prefilter-includes also looks in the
+//  headers they include with quotes.
+//
+//  With -main-file-only, matchers see only the top-level declarations in
+//  the main file and in headers under the -allow-dir directories; see
+//  checks/MainFileMatch.h.
+//
+//  With -stdin, the contents of the one source file are read from stdin and
+//  the rewritten source is written to stdout; nothing on disk is changed.
+//  -print-replacements writes the replacements instead, one per line as
+//  <offset>:<length>:<text>.  A compile command is still needed, and is
+//  most easily given after "--", e.g.:
+//
+//    $ remove-cstr-calls -stdin . file.cpp -- -Iinclude < file.cpp
+//
 //===----------------------------------------------------------------------===//
 
-#include "clang/ASTMatchers/ASTMatchers.h"
+#include "CStrCallCheck.h"
+#include "MainFileMatch.h"
+#include "PchCompilationDatabase.h"
+#include "Prefilter.h"
+#include "ReplacementWriter.h"
 #include "clang/ASTMatchers/ASTMatchFinder.h"
-#include "clang/Basic/SourceManager.h"
 #include "clang/Frontend/FrontendActions.h"
-#include "clang/Lex/Lexer.h"
 #include "clang/Tooling/CompilationDatabase.h"
 #include "clang/Tooling/Refactoring.h"
 #include "clang/Tooling/Tooling.h"
@@ -47,139 +78,285 @@
 #include "llvm/Support/CommandLine.h"
 #include "llvm/Support/MemoryBuffer.h"
 #include "llvm/Support/Path.h"
+#include "llvm/Support/Threading.h"
 #include "llvm/Support/raw_ostream.h"
 #include "llvm/Support/system_error.h"
 
+#include <algorithm>
+#include <map>
+#include <pthread.h>
+
 using namespace clang;
 using namespace clang::ast_matchers;
 using namespace llvm;
 using clang::tooling::newFrontendActionFactory;
 using clang::tooling::Replacement;
 using clang::tooling::CompilationDatabase;
+using clang::checks::FixCStrCall;
+using clang::checks::addCStrCallMatchers;
 
-// FIXME: Pull out helper methods in here into more fitting places.
-
-// Returns the text that makes up 'node' in the source.
-// Returns an empty string if the text cannot be found.
-template <typename T>
-static std::string getText(const SourceManager &SourceManager, const T &Node) {
-  SourceLocation StartSpellingLocatino =
-      SourceManager.getSpellingLoc(Node.getLocStart());
-  SourceLocation EndSpellingLocation =
-      SourceManager.getSpellingLoc(Node.getLocEnd());
-  if (!StartSpellingLocatino.isValid() || !EndSpellingLocation.isValid()) {
-    return std::string();
-  }
-  bool Invalid = true;
-  const char *Text =
-      SourceManager.getCharacterData(StartSpellingLocatino, &Invalid);
-  if (Invalid) {
-    return std::string();
+cl::opt<std::string> BuildPath(
+  cl::Positional,
+  cl::desc("<build-path>"));
+
+cl::list<std::string> SourcePaths(
+  cl::Positional,
+  cl::desc("<source0> [... <sourceN>]"),
+  cl::OneOrMore);
+
+cl::opt<unsigned> Jobs(
+  "j",
+  cl::desc("Number of files to parse at once"),
+  cl::init(1));
+
+cl::opt<bool> Stdin(
+  "stdin",
+  cl::desc("Read the source from stdin and write the result to stdout"));
+
+cl::opt<bool> PrintReplacements(
+  "print-replacements",
+  cl::desc("With -stdin, write the replacements instead of the source"));
+
+cl::opt<std::string> PchDir(
+  "pch-dir",
+  cl::desc("Precompile the #includes shared by files with the same "
+           "compile command into <dir>, and parse them once"),
+  cl::value_desc("dir"));
+
+cl::opt<bool> Prefilter(
+  "prefilter",
+  cl::desc("Skip files that don't spell out c_str, without parsing them"));
+
+cl::opt<bool> PrefilterIncludes(
+  "prefilter-includes",
+  cl::desc("With -prefilter, also look in the headers each file "
+           "includes with quotes"));
+
+cl::opt<bool> MainFileOnly(
+  "main-file-only",
+  cl::desc("Match only in top-level declarations of the main file and of "
+           "headers under -allow-dir"));
+
+cl::list<std::string> AllowDirs(
+  "allow-dir",
+  cl::desc("With -main-file-only, also match in headers under <dir>"),
+  cl::value_desc("dir"));
+
+// AllowDirs, made absolute before any compile command changes directory.
+static std::vector<std::string> AllowedDirs;
+
+static tooling::FrontendActionFactory *newActionFactory(
+    ast_matchers::MatchFinder *Finder) {
+  if (MainFileOnly)
+    return checks::newMainFileMatchActionFactory(Finder, AllowedDirs);
+  return newFrontendActionFactory(Finder);
+}
+
+namespace {
+// Runs the matchers over the source paths on several threads.  Each
+// thread takes the next path when it is done with the last one.  Each
+// file's replacements go to a ReplacementWriter as soon as it is parsed,
+// which writes every file once no file still to be parsed can edit it.
+// The writer settles identical and conflicting edits the same way
+// whatever order the files were parsed in.
+//
+// ClangTool changes into each compile command's directory, for the whole
+// process.  The files are therefore run in groups that share a directory,
+// one group after the other, with only the files of one group in flight.
+class ParallelRun {
+ public:
+  ParallelRun(const CompilationDatabase &Compilations,
+              const std::vector<std::string> &Paths)
+      : Compilations(Compilations), SourcePaths(absolutePaths(Paths)),
+        Writer(SourcePaths), Group(NULL), Next(0), Result(0) {
+    pthread_mutex_init(&Lock, NULL);
+    groupByDirectory();
   }
-  std::pair<FileID, unsigned> Start =
-      SourceManager.getDecomposedLoc(StartSpellingLocatino);
-  std::pair<FileID, unsigned> End =
-      SourceManager.getDecomposedLoc(Lexer::getLocForEndOfToken(
-          EndSpellingLocation, 0, SourceManager, LangOptions()));
-  if (Start.first != End.first) {
-    // Start and end are in different files.
-    return std::string();
+  ~ParallelRun() {
+    pthread_mutex_destroy(&Lock);
   }
-  if (End.second < Start.second) {
-    // Shuffling text with macros may cause this.
-    return std::string();
+
+  // Returns non-zero if any file failed to parse or to be written.
+  int run(unsigned Jobs) {
+    for (unsigned G = 0, E = Groups.size(); G != E; ++G) {
+      Group = &Groups[G];
+      Next = 0;
+      unsigned Threads = std::min<unsigned>(Jobs, Group->size());
+      std::vector<pthread_t> Handles(Threads);
+      unsigned Started = 0;
+      for (; Threads > 1 && Started < Threads; ++Started) {
+        if (pthread_create(&Handles[Started], NULL, &ParallelRun::worker,
+                           this))
+          break;
+      }
+      // With one job, or no threads at all, do the work here.
+      if (Started == 0)
+        worker(this);
+      for (unsigned I = 0; I < Started; ++I)
+        pthread_join(Handles[I], NULL);
+    }
+    if (Writer.finish() != 0)
+      Result = 1;
+    return Result;
   }
-  return std::string(Text, End.second - Start.second);
-}
 
-// Return true if expr needs to be put in parens when it is an
-// argument of a prefix unary operator, e.g. when it is a binary or
-// ternary operator syntactically.
-static bool needParensAfterUnaryOperator(const Expr &ExprNode) {
-  if (dyn_cast<clang::BinaryOperator>(&ExprNode) ||
-      dyn_cast<clang::ConditionalOperator>(&ExprNode)) {
-    return true;
+ private:
+  static void *worker(void *Arg) {
+    ParallelRun *Run = static_cast<ParallelRun*>(Arg);
+    tooling::Replacements Replace;
+    ast_matchers::MatchFinder Finder;
+    FixCStrCall Callback(&Replace);
+    addCStrCallMatchers(Finder, Callback);
+    llvm::OwningPtr<tooling::FrontendActionFactory> Factory(
+        newActionFactory(&Finder));
+
+    unsigned Index;
+    while (Run->next(Index)) {
+      tooling::ClangTool Tool(Run->Compilations, Run->SourcePaths[Index]);
+      int Result = Tool.run(Factory.get());
+      Run->done(Index, Replace, Result);
+      Replace.clear();
+    }
+    return NULL;
   }
-  if (const CXXOperatorCallExpr *op =
-      dyn_cast<CXXOperatorCallExpr>(&ExprNode)) {
-    return op->getNumArgs() == 2 &&
-        op->getOperator() != OO_PlusPlus &&
-        op->getOperator() != OO_MinusMinus &&
-        op->getOperator() != OO_Call &&
-        op->getOperator() != OO_Subscript;
+
+  // Resolves the paths before any thread changes directory.
+  static std::vector<std::string> absolutePaths(
+      const std::vector<std::string> &Paths) {
+    std::vector<std::string> Absolute;
+    for (unsigned I = 0, E = Paths.size(); I != E; ++I)
+      Absolute.push_back(tooling::getAbsolutePath(Paths[I]));
+    return Absolute;
   }
-  return false;
-}
 
-// Format a pointer to an expression: prefix with '*' but simplify
-// when it already begins with '&'.  Return empty string on failure.
-static std::string formatDereference(const SourceManager &SourceManager,
-                              const Expr &ExprNode) {
-  if (const clang::UnaryOperator *Op =
-      dyn_cast<clang::UnaryOperator>(&ExprNode)) {
-    if (Op->getOpcode() == UO_AddrOf) {
-      // Strip leading '&'.
-      return getText(SourceManager, *Op->getSubExpr()->IgnoreParens());
+  // Groups the files by the directory of their compile commands, in the
+  // order the directories are first seen.  A file whose commands don't
+  // agree on one gets a group to itself.
+  void groupByDirectory() {
+    std::map<std::string, unsigned> GroupOf;
+    for (unsigned I = 0, E = SourcePaths.size(); I != E; ++I) {
+      std::vector<tooling::CompileCommand> Commands =
+          Compilations.getCompileCommands(SourcePaths[I]);
+      bool Mixed = false;
+      for (unsigned J = 1, F = Commands.size(); J < F; ++J)
+        Mixed = Mixed || Commands[J].Directory != Commands[0].Directory;
+      if (Mixed || Commands.empty()) {
+        Groups.push_back(std::vector<unsigned>(1, I));
+        continue;
+      }
+      std::map<std::string, unsigned>::iterator Found =
+          GroupOf.find(Commands[0].Directory);
+      if (Found == GroupOf.end()) {
+        Found = GroupOf.insert(
+            std::make_pair(Commands[0].Directory, Groups.size())).first;
+        Groups.push_back(std::vector<unsigned>());
+      }
+      Groups[Found->second].push_back(I);
     }
   }
-  const std::string Text = getText(SourceManager, ExprNode);
-  if (Text.empty()) return std::string();
-  // Add leading '*'.
-  if (needParensAfterUnaryOperator(ExprNode)) {
-    return std::string("*(") + Text + ")";
+
+  bool next(unsigned &Index) {
+    pthread_mutex_lock(&Lock);
+    bool Found = Next < Group->size();
+    if (Found)
+      Index = (*Group)[Next++];
+    pthread_mutex_unlock(&Lock);
+    return Found;
   }
-  return std::string("*") + Text;
-}
 
-namespace {
-class FixCStrCall : public ast_matchers::MatchFinder::MatchCallback {
- public:
-  FixCStrCall(tooling::Replacements *Replace)
-      : Replace(Replace) {}
-
-  virtual void run(const ast_matchers::MatchFinder::MatchResult &Result) {
-    const CallExpr *Call =
-        Result.Nodes.getStmtAs<CallExpr>("call");
-    const Expr *Arg =
-        Result.Nodes.getStmtAs<Expr>("arg");
-    const bool Arrow =
-        Result.Nodes.getStmtAs<MemberExpr>("member")->isArrow();
-    // Replace the "call" node with the "arg" node, prefixed with '*'
-    // if the call was using '->' rather than '.'.
-    const std::string ArgText = Arrow ?
-        formatDereference(*Result.SourceManager, *Arg) :
-        getText(*Result.SourceManager, *Arg);
-    if (ArgText.empty()) return;
-
-    Replace->insert(Replacement(*Result.SourceManager, Call, ArgText));
+  void done(unsigned Index, const tooling::Replacements &Replace,
+            int FileResult) {
+    pthread_mutex_lock(&Lock);
+    // A file that failed to parse may have matched only part of itself, so
+    // none of its edits are made.
+    if (Writer.add(Index, FileResult == 0 ? Replace
+                                          : tooling::Replacements()) != 0)
+      Result = 1;
+    if (FileResult != 0)
+      Result = FileResult;
+    pthread_mutex_unlock(&Lock);
   }
 
- private:
-  tooling::Replacements *Replace;
+  const CompilationDatabase &Compilations;
+  const std::vector<std::string> SourcePaths;
+  checks::ReplacementWriter Writer;
+  std::vector<std::vector<unsigned> > Groups;
+  pthread_mutex_t Lock;
+  // The group being run, and the next file in it.
+  const std::vector<unsigned> *Group;
+  unsigned Next;
+  int Result;
 };
 } // end namespace
 
-const char *StringConstructor =
-    "::std::basic_string<char, std::char_traits<char>, std::allocator<char> >"
-    "::basic_string";
+// Runs the matchers over the source on stdin, mapped to the one source
+// path, and writes the rewritten source or its replacements to stdout.
+static int runOnStdin(const CompilationDatabase &Compilations) {
+  if (SourcePaths.size() != 1) {
+    llvm::errs() << "-stdin takes exactly one source path.\n";
+    return 1;
+  }
+  llvm::OwningPtr<MemoryBuffer> Input;
+  if (error_code EC = MemoryBuffer::getSTDIN(Input)) {
+    llvm::errs() << "Could not read stdin: " << EC.message() << "\n";
+    return 1;
+  }
+  const std::string Path = tooling::getAbsolutePath(SourcePaths[0]);
+  tooling::ClangTool Tool(Compilations, Path);
+  Tool.mapVirtualFile(Path, Input->getBuffer());
 
-const char *StringCStrMethod =
-    "::std::basic_string<char, std::char_traits<char>, std::allocator<char> >"
-    "::c_str";
+  tooling::Replacements Replace;
+  ast_matchers::MatchFinder Finder;
+  FixCStrCall Callback(&Replace);
+  addCStrCallMatchers(Finder, Callback);
+  llvm::OwningPtr<tooling::FrontendActionFactory> Factory(
+      newActionFactory(&Finder));
+  if (int Result = Tool.run(Factory.get()))
+    return Result;
 
-cl::opt<std::string> BuildPath(
-  cl::Positional,
-  cl::desc("<build-path>"));
+  // Only the source itself is rewritten; edits to headers are dropped.
+  std::vector<Replacement> Edits;
+  for (tooling::Replacements::const_iterator I = Replace.begin(),
+                                             E = Replace.end();
+       I != E; ++I) {
+    if (I->getFilePath() == Path)
+      Edits.push_back(*I);
+  }
 
-cl::list<std::string> SourcePaths(
-  cl::Positional,
-  cl::desc("<source0> [... <sourceN>]"),
-  cl::OneOrMore);
+  if (PrintReplacements) {
+    for (unsigned I = 0, E = Edits.size(); I != E; ++I) {
+      llvm::outs() << Edits[I].getOffset() << ":" << Edits[I].getLength()
+                   << ":" << Edits[I].getReplacementText() << "\n";
+    }
+    return 0;
+  }
+
+  // Edits are ordered by offset; apply them from the end so the offsets of
+  // the ones before stay valid.
+  std::string Code = Input->getBuffer();
+  size_t End = Code.size();
+  bool Skipped = false;
+  for (unsigned I = Edits.size(); I-- > 0; ) {
+    if (Edits[I].getOffset() + Edits[I].getLength() > End) {
+      Skipped = true;
+      continue;
+    }
+    Code.replace(Edits[I].getOffset(), Edits[I].getLength(),
+                 Edits[I].getReplacementText());
+    End = Edits[I].getOffset();
+  }
+  if (Skipped)
+    llvm::errs() << "Skipped some replacements.\n";
+  llvm::outs() << Code;
+  return 0;
+}
 
 int main(int argc, const char **argv) {
   llvm::OwningPtr<CompilationDatabase> Compilations(
     tooling::FixedCompilationDatabase::loadFromCommandLine(argc, argv));
   cl::ParseCommandLineOptions(argc, argv);
+  for (unsigned I = 0, E = AllowDirs.size(); I != E; ++I)
+    AllowedDirs.push_back(tooling::getAbsolutePath(AllowDirs[I]));
   if (!Compilations) {
     std::string ErrorMessage;
     Compilations.reset(
@@ -187,51 +364,27 @@ int main(int argc, const char **argv) {
     if (!Compilations)
       llvm::report_fatal_error(ErrorMessage);
     }
-  tooling::RefactoringTool Tool(*Compilations, SourcePaths);
-  ast_matchers::MatchFinder Finder;
-  FixCStrCall Callback(&Tool.getReplacements());
-  Finder.addMatcher(
-      constructorCall(
-          hasDeclaration(method(hasName(StringConstructor))),
-          argumentCountIs(2),
-          // The first argument must have the form x.c_str() or p->c_str()
-          // where the method is string::c_str().  We can use the copy
-          // constructor of string instead (or the compiler might share
-          // the string object).
-          hasArgument(
-              0,
-              id("call", memberCall(
-                  callee(id("member", memberExpression())),
-                  callee(method(hasName(StringCStrMethod))),
-                  on(id("arg", expression()))))),
-          // The second argument is the alloc object which must not be
-          // present explicitly.
-          hasArgument(
-              1,
-              defaultArgument())),
-      &Callback);
-  Finder.addMatcher(
-      constructorCall(
-          // Implicit constructors of these classes are overloaded
-          // wrt. string types and they internally make a StringRef
-          // referring to the argument.  Passing a string directly to
-          // them is preferred to passing a char pointer.
-          hasDeclaration(method(anyOf(
-              hasName("::llvm::StringRef::StringRef"),
-              hasName("::llvm::Twine::Twine")))),
-          argumentCountIs(1),
-          // The only argument must have the form x.c_str() or p->c_str()
-          // where the method is string::c_str().  StringRef also has
-          // a constructor from string which is more efficient (avoids
-          // strlen), so we can construct StringRef from the string
-          // directly.
-          hasArgument(
-              0,
-              id("call", memberCall(
-                  callee(id("member", memberExpression())),
-                  callee(method(hasName(StringCStrMethod))),
-                  on(id("arg", expression())))))),
-      &Callback);
-  return Tool.run(newFrontendActionFactory(&Finder));
+  if (Stdin)
+    return runOnStdin(*Compilations);
+  std::vector<std::string> Files(SourcePaths.begin(), SourcePaths.end());
+  if (Prefilter) {
+    std::vector<std::string> Triggers(1, checks::CStrCallTrigger);
+    std::vector<std::string> Kept;
+    unsigned Skipped =
+        checks::prefilter(Files, Triggers, PrefilterIncludes, Kept);
+    llvm::errs() << "Skipped " << Skipped << " of " << Files.size()
+                 << " files without " << checks::CStrCallTrigger << ".\n";
+    Files.swap(Kept);
+  }
+  llvm::OwningPtr<checks::PchCompilationDatabase> Pch;
+  if (!PchDir.empty()) {
+    Pch.reset(new checks::PchCompilationDatabase(*Compilations, PchDir));
+    Pch->build(Files);
+  }
+  const CompilationDatabase &Commands = Pch ? *Pch : *Compilations;
+  ParallelRun Run(Commands, Files);
+  if (Jobs > 1)
+    llvm::llvm_start_multithreaded();
+  return Run.run(Jobs);
 }
 
@@ -0,0 +1,239 @@
+//===- tools/extra/run-checks/RunChecks.cpp - Run many checks at once -----===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+//  This file implements a tool that runs any number of the checks in the
+//  CheckRegistry over a set of files with a single parse of each.  All the
+//  checks' matchers go into one MatchFinder; each check's replacements are
+//  kept apart and counted, then written together file by file.
+//
+//  Usage:
+//  run-checks [-checks=<check>,...] <cmake-output-dir> <file1> <file2> ...
+//  run-checks -list-checks
+//
+//  The files are given as for remove-cstr-calls, and -pch-dir, -prefilter
+//  and -main-file-only work as they do there; -prefilter skips a file only
+//  if no enabled check could match in it.  Without -checks, every
+//  registered check is run.
+//
+//===----------------------------------------------------------------------===//
+
+#include "Check.h"
+#include "MainFileMatch.h"
+#include "PchCompilationDatabase.h"
+#include "Prefilter.h"
+#include "ReplacementWriter.h"
+#include "clang/ASTMatchers/ASTMatchFinder.h"
+#include "clang/Frontend/FrontendActions.h"
+#include "clang/Tooling/CompilationDatabase.h"
+#include "clang/Tooling/Refactoring.h"
+#include "clang/Tooling/Tooling.h"
+#include "llvm/ADT/OwningPtr.h"
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/ADT/StringRef.h"
+#include "llvm/Support/CommandLine.h"
+#include "llvm/Support/raw_ostream.h"
+
+#include <algorithm>
+
+using namespace clang;
+using namespace llvm;
+using clang::checks::Check;
+using clang::checks::CheckInfo;
+using clang::checks::CheckRegistry;
+using clang::tooling::newFrontendActionFactory;
+using clang::tooling::CompilationDatabase;
+
+cl::opt<std::string> BuildPath(
+  cl::Positional,
+  cl::desc("<build-path>"));
+
+cl::list<std::string> SourcePaths(
+  cl::Positional,
+  cl::desc("<source0> [... <sourceN>]"),
+  cl::ZeroOrMore);
+
+cl::opt<std::string> ChecksToRun(
+  "checks",
+  cl::desc("Comma-separated list of checks to run (default: all)"));
+
+cl::opt<bool> ListChecks(
+  "list-checks",
+  cl::desc("List the available checks and exit"));
+
+cl::opt<std::string> PchDir(
+  "pch-dir",
+  cl::desc("Precompile the #includes shared by files with the same "
+           "compile command into <dir>, and parse them once"),
+  cl::value_desc("dir"));
+
+cl::opt<bool> Prefilter(
+  "prefilter",
+  cl::desc("Skip files that spell out none of the identifiers the checks "
+           "need to match, without parsing them"));
+
+cl::opt<bool> PrefilterIncludes(
+  "prefilter-includes",
+  cl::desc("With -prefilter, also look in the headers each file "
+           "includes with quotes"));
+
+cl::opt<bool> MainFileOnly(
+  "main-file-only",
+  cl::desc("Match only in top-level declarations of the main file and of "
+           "headers under -allow-dir"));
+
+cl::list<std::string> AllowDirs(
+  "allow-dir",
+  cl::desc("With -main-file-only, also match in headers under <dir>"),
+  cl::value_desc("dir"));
+
+// AllowDirs, made absolute before any compile command changes directory.
+static std::vector<std::string> AllowedDirs;
+
+static tooling::FrontendActionFactory *newActionFactory(
+    ast_matchers::MatchFinder *Finder) {
+  if (MainFileOnly)
+    return checks::newMainFileMatchActionFactory(Finder, AllowedDirs);
+  return newFrontendActionFactory(Finder);
+}
+
+// Fills Enabled with the checks named by -checks, or all of them.  Returns
+// false if a name is unknown.
+static bool selectChecks(std::vector<const CheckInfo *> &Enabled) {
+  const std::vector<CheckInfo> &All = CheckRegistry::checks();
+  if (ChecksToRun.empty()) {
+    for (unsigned I = 0, E = All.size(); I != E; ++I)
+      Enabled.push_back(&All[I]);
+    return true;
+  }
+  SmallVector<StringRef, 8> Names;
+  StringRef(ChecksToRun).split(Names, ",");
+  for (unsigned I = 0, E = Names.size(); I != E; ++I) {
+    StringRef Name = Names[I].trim();
+    if (Name.empty())
+      continue;
+    const CheckInfo *Info = CheckRegistry::find(Name);
+    if (!Info) {
+      llvm::errs() << "Unknown check: " << Name << "\n";
+      return false;
+    }
+    // Naming a check twice runs it once.
+    if (std::find(Enabled.begin(), Enabled.end(), Info) == Enabled.end())
+      Enabled.push_back(Info);
+  }
+  return true;
+}
+
+int main(int argc, const char **argv) {
+  llvm::OwningPtr<CompilationDatabase> Compilations(
+    tooling::FixedCompilationDatabase::loadFromCommandLine(argc, argv));
+  cl::ParseCommandLineOptions(argc, argv);
+  for (unsigned I = 0, E = AllowDirs.size(); I != E; ++I)
+    AllowedDirs.push_back(tooling::getAbsolutePath(AllowDirs[I]));
+
+  if (ListChecks) {
+    const std::vector<CheckInfo> &All = CheckRegistry::checks();
+    for (unsigned I = 0, E = All.size(); I != E; ++I)
+      llvm::outs() << All[I].Name << " - " << All[I].Description << "\n";
+    return 0;
+  }
+  if (SourcePaths.empty()) {
+    llvm::errs() << "No source files given.\n";
+    return 1;
+  }
+  std::vector<const CheckInfo *> Enabled;
+  if (!selectChecks(Enabled))
+    return 1;
+
+  if (!Compilations) {
+    std::string ErrorMessage;
+    Compilations.reset(
+           CompilationDatabase::loadFromDirectory(BuildPath, ErrorMessage));
+    if (!Compilations)
+      llvm::report_fatal_error(ErrorMessage);
+    }
+
+  // Replacements are tracked per check, so each sizes its own; the vector
+  // is never resized once the checks hold pointers into it.
+  std::vector<tooling::Replacements> Replace(Enabled.size());
+  std::vector<Check *> Checks;
+  ast_matchers::MatchFinder Finder;
+  for (unsigned I = 0, E = Enabled.size(); I != E; ++I) {
+    Checks.push_back(Enabled[I]->Create());
+    Checks.back()->registerMatchers(Finder, &Replace[I]);
+  }
+
+  // A file can be skipped only if it has none of any check's triggers.
+  std::vector<std::string> Files(SourcePaths.begin(), SourcePaths.end());
+  if (Prefilter) {
+    std::vector<std::string> Triggers;
+    bool CanSkip = true;
+    for (unsigned I = 0, E = Checks.size(); I != E; ++I) {
+      if (!Checks[I]->getTriggers(Triggers))
+        CanSkip = false;
+    }
+    if (CanSkip) {
+      std::vector<std::string> Kept;
+      unsigned Skipped =
+          checks::prefilter(Files, Triggers, PrefilterIncludes, Kept);
+      llvm::errs() << "Skipped " << Skipped << " of " << Files.size()
+                   << " files.\n";
+      Files.swap(Kept);
+    } else {
+      llvm::errs() << "Not every check can be prefiltered; "
+                   << "ignoring -prefilter.\n";
+    }
+  }
+
+  llvm::OwningPtr<checks::PchCompilationDatabase> Pch;
+  if (!PchDir.empty()) {
+    Pch.reset(new checks::PchCompilationDatabase(*Compilations, PchDir));
+    Pch->build(Files);
+  }
+  const CompilationDatabase &Commands = Pch ? *Pch : *Compilations;
+
+  // Each file's edits are handed to the writer once it is parsed, so
+  // files are written as the run goes.  Two checks making the same edit
+  // make it once.
+  for (unsigned I = 0, E = Files.size(); I != E; ++I)
+    Files[I] = tooling::getAbsolutePath(Files[I]);
+  checks::ReplacementWriter Writer(Files);
+  std::vector<unsigned> Counts(Enabled.size());
+  llvm::OwningPtr<tooling::FrontendActionFactory> Factory(
+      newActionFactory(&Finder));
+  int Result = 0;
+  for (unsigned I = 0, E = Files.size(); I != E; ++I) {
+    tooling::ClangTool Tool(Commands, Files[I]);
+    // A file that failed to parse may have matched only part of itself, so
+    // none of its edits are made or counted.
+    bool Failed = Tool.run(Factory.get()) != 0;
+    if (Failed)
+      Result = 1;
+    tooling::Replacements FileReplace;
+    for (unsigned J = 0, F = Enabled.size(); J != F; ++J) {
+      if (!Failed) {
+        Counts[J] += Replace[J].size();
+        FileReplace.insert(Replace[J].begin(), Replace[J].end());
+      }
+      Replace[J].clear();
+    }
+    if (Writer.add(I, FileReplace) != 0)
+      Result = 1;
+  }
+  if (Writer.finish() != 0)
+    Result = 1;
+
+  for (unsigned I = 0, E = Enabled.size(); I != E; ++I) {
+    llvm::outs() << Enabled[I]->Name << ": " << Counts[I]
+                 << " replacements\n";
+    delete Checks[I];
+  }
+  if (Writer.numConflicts())
+    llvm::outs() << Writer.numConflicts() << " conflicting replacements\n";
+  return Result;
+}
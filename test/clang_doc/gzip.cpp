@@ -0,0 +1,13 @@
+// RUN: rm -rf "%T/gzip" && mkdir -p "%T/gzip/html" "%T/gzip/obj"
+// RUN: cp "%s" "%T/gzip/gzip.cpp"
+// RUN: clang_doc -R "%T/gzip" -D "%T/gzip/html" -O "%T/gzip/obj" \
+// RUN:   -f "%T/gzip/gzip.cpp" --gzip -- > /dev/null
+// RUN: not test -e "%T/gzip/html/gzip.cpp.html"
+// RUN: gzip -dc "%T/gzip/html/gzip.cpp.html.gz" | FileCheck %s
+// REQUIRES: clang_doc, shell
+
+// Only the compressed page is written, and it holds the whole page.
+// CHECK: gzip_me
+// CHECK: </body></html>
+
+int gzip_me(int x) { return x; }
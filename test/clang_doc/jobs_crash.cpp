@@ -0,0 +1,19 @@
+// RUN: rm -rf "%T/jobs_crash" && mkdir -p "%T/jobs_crash/html" "%T/jobs_crash/obj"
+// RUN: cp "%s" "%T/jobs_crash/good.cpp"
+// RUN: echo '#pragma clang __debug crash' > "%T/jobs_crash/crash.cpp"
+// RUN: (printf '%%s\n' "%T/jobs_crash/crash.cpp" "%T/jobs_crash/good.cpp" \
+// RUN:   | env LIBCLANG_DISABLE_CRASH_RECOVERY=1 clang_doc -j 2 \
+// RUN:       -R "%T/jobs_crash" -D "%T/jobs_crash/html" -O "%T/jobs_crash/obj" \
+// RUN:       -- 2>&1; echo end) | FileCheck %s
+// RUN: FileCheck -check-prefix=PAGE %s < "%T/jobs_crash/html/good.cpp.html"
+// RUN: not test -e "%T/jobs_crash/html/crash.cpp.html"
+// REQUIRES: clang_doc, shell
+
+// crash.cpp kills the worker parsing it, both times it's tried, so it's
+// skipped; the other worker still renders good.cpp, and the run goes on.
+// CHECK: error: skipping "{{.*}}/crash.cpp", it crashed clang_doc twice
+// CHECK: wrote {{[1-9][0-9]*}} files
+// CHECK: end
+// PAGE: survive_me
+
+int survive_me(int x) { return x; }
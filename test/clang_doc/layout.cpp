@@ -0,0 +1,18 @@
+// RUN: rm -rf "%T/layout" && mkdir -p "%T/layout/html" "%T/layout/obj"
+// RUN: cp "%s" "%T/layout/layout.cpp"
+// RUN: clang_doc -R "%T/layout" -D "%T/layout/html" -O "%T/layout/obj" \
+// RUN:   -f "%T/layout/layout.cpp" -T "%T/layout/tags" --layout=hashed \
+// RUN:   -- > /dev/null
+// RUN: not test -e "%T/layout/html/layout.cpp.html"
+// RUN: ls "%T/layout/html"/*/layout.cpp.html | FileCheck %s
+// RUN: cat "%T/layout/html"/*/layout.cpp.html | FileCheck -check-prefix=PAGE %s
+// RUN: FileCheck -check-prefix=TAGS %s < "%T/layout/tags"
+// REQUIRES: clang_doc, shell
+
+// The page goes one subdirectory down, so its links to shared files lead
+// back up, and the tag file records the layout for other projects.
+// CHECK: /layout/html/{{[0-9a-f][0-9a-f]}}/layout.cpp.html
+// PAGE: href="../doxygen.css"
+// TAGS: !layout hashed
+
+int layout_me(int x) { return x; }
@@ -0,0 +1,17 @@
+// RUN: rm -rf "%T/relink" && mkdir -p "%T/relink/html" "%T/relink/obj"
+// RUN: cp "%s" "%T/relink/relink.cpp"
+// RUN: clang_doc -R "%T/relink" -D "%T/relink/html" -O "%T/relink/obj" \
+// RUN:   -f "%T/relink/relink.cpp" -- > /dev/null
+// RUN: clang_doc -R "%T/relink" -D "%T/relink/html" -O "%T/relink/obj" \
+// RUN:   -f "%T/relink/relink.cpp" --relink -- | FileCheck %s
+// RUN: FileCheck -check-prefix=PAGE %s < "%T/relink/html/relink.cpp.html"
+// REQUIRES: clang_doc, shell
+
+// The source hasn't changed since the first run rendered it, so the
+// second takes the page from the render cache, and it comes out the same.
+// CHECK: relinked 1 of 1 pages from the render cache
+// PAGE: href="#l{{[0-9]+}}" title="">relink_callee</a>
+
+int relink_callee(int x) { return x; }
+
+int relink_caller(int y) { return relink_callee(y); }
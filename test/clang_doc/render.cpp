@@ -0,0 +1,12 @@
+// RUN: clang_doc --render=%T/no/such/dir/render.cpp -- -I%T/no/such/include \
+// RUN:   < "%s" | FileCheck %s
+// REQUIRES: clang_doc, shell
+
+// Neither the buffer's directory nor the -I directory exists, so the
+// include below can't be resolved; the page is still rendered, and the
+// include is left unlinked.
+#include "missing.h"
+// CHECK: &quot;missing.h&quot;
+// CHECK: </body></html>
+
+int render_me(int x) { return x; }
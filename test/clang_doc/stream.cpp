@@ -0,0 +1,19 @@
+// RUN: rm -rf "%T/stream" && mkdir -p "%T/stream/html" "%T/stream/obj"
+// RUN: cp "%s" "%T/stream/stream.cpp"
+// RUN: clang_doc -R "%T/stream" -D "%T/stream/html" -O "%T/stream/obj" \
+// RUN:   -f "%T/stream/stream.cpp" --format=stream -- > /dev/null
+// RUN: FileCheck %s < "%T/stream/html/stream.cpp.html"
+// RUN: test -s "%T/stream/html/clang_doc.js"
+// REQUIRES: clang_doc, shell
+
+// The page carries the token stream and loads clang_doc.js, which the
+// run writes next to it, instead of marking up every token.
+// CHECK: <pre class="fragment" id="clang_doc_src"></pre>
+// CHECK-SAME: id="clang_doc_tokens">
+// CHECK: |kint| |{{[ai]}}
+// CHECK-SAME: stream_me
+// CHECK: |kreturn|
+// CHECK: id="clang_doc_links">[
+// CHECK-SAME: src="clang_doc.js"
+
+int stream_me(int x) { return x; }
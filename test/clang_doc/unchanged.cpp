@@ -0,0 +1,16 @@
+// RUN: rm -rf "%T/unchanged" && mkdir -p "%T/unchanged/html" "%T/unchanged/obj"
+// RUN: cp "%s" "%T/unchanged/unchanged.cpp"
+// RUN: clang_doc -R "%T/unchanged" -D "%T/unchanged/html" -O "%T/unchanged/obj" \
+// RUN:   -f "%T/unchanged/unchanged.cpp" -- | FileCheck -check-prefix=FIRST %s
+// RUN: clang_doc -R "%T/unchanged" -D "%T/unchanged/html" -O "%T/unchanged/obj" \
+// RUN:   -f "%T/unchanged/unchanged.cpp" -- | FileCheck -check-prefix=SECOND %s
+// RUN: FileCheck -check-prefix=PAGE %s < "%T/unchanged/html/unchanged.cpp.html"
+// REQUIRES: clang_doc, shell
+
+// Nothing changed between the runs, so the second one leaves every page
+// as it was.
+// FIRST: wrote {{[1-9][0-9]*}} files, 0 unchanged
+// SECOND: wrote 0 files, {{[1-9][0-9]*}} unchanged
+// PAGE: unchanged_me
+
+int unchanged_me(int x) { return x; }
@@ -0,0 +1,35 @@
+// RUN: rm -rf "%T/xref" && mkdir -p "%T/xref/html" "%T/xref/obj"
+// RUN: cp "%s" "%T/xref/xref.cpp"
+// RUN: clang_doc -R "%T/xref" -D "%T/xref/html" -O "%T/xref/obj" \
+// RUN:   -f "%T/xref/xref.cpp" -x "%T/xref/index" -- > /dev/null
+// RUN: FileCheck %s < "%T/xref/html/xref.cpp.refs.html"
+// RUN: clang_doc -x "%T/xref/index" -u 'xref_target(int)' \
+// RUN:   | FileCheck -check-prefix=USES %s
+// RUN: (clang_doc -x "%T/xref/index" -u 'xref_unused(int)'; echo end) \
+// RUN:   | FileCheck -check-prefix=NONE %s
+// RUN: head -c 64 "%T/xref/index" > "%T/xref/truncated"
+// RUN: not clang_doc -x "%T/xref/truncated" -u 'xref_target(int)' 2>&1 \
+// RUN:   | FileCheck -check-prefix=BAD %s
+// REQUIRES: clang_doc, shell
+
+// The page lists xref_target's uses on lines 33 and 34, and --uses reads
+// the same from the index.  A truncated index is refused.
+// CHECK: References to definitions in <a class="code" href="xref.cpp.html">
+// CHECK: name="xref_target(int)" href="xref.cpp.html#l00030"
+// CHECK: {{.*}}/xref.cpp:33</a>
+// CHECK: {{.*}}/xref.cpp:34</a>
+// USES: {{.*}}/xref.cpp:33
+// USES-NEXT: {{.*}}/xref.cpp:34
+// NONE-NOT: xref.cpp
+// NONE: end
+// BAD: error: could not read xref index
+
+int xref_unused(int x) { return x; }
+
+int
+xref_target(int x) { return x + 1; }
+
+int xref_user(int y) {
+  int a = xref_target(y);
+  return xref_target(a);
+}
@@ -0,0 +1,33 @@
+// RUN: rm -rf "%T/allow" && mkdir -p "%T/allow/lib" "%T/allow/other"
+// RUN: cp "%s" "%T/allow/lib/allowed.h"
+// RUN: echo 'inline void f2(const std::string &s) { f2(s.c_str()); }' > "%T/allow/other/skipped.h"
+// RUN: printf '#include "lib/allowed.h"\n#include "other/skipped.h"\nvoid f3(const std::string &s) { f2(s); f3(s.c_str()); }\n' > "%T/allow/main.cpp"
+// RUN: echo '[{"directory":"%T/allow","command":"clang++ -c main.cpp","file":"%T/allow/main.cpp"}]' > "%T/allow/compile_commands.json"
+// RUN: remove-cstr-calls -main-file-only -allow-dir "%T/allow/lib/" "%T/allow" "%T/allow/main.cpp"
+// RUN: cat "%T/allow/lib/allowed.h" | FileCheck %s
+// RUN: cat "%T/allow/other/skipped.h" | FileCheck -check-prefix=SKIPPED %s
+// RUN: cat "%T/allow/main.cpp" | FileCheck -check-prefix=MAIN %s
+// REQUIRES: shell
+
+// This file is a header under -allow-dir, so its call is fixed like the
+// main file's; the header outside it is left alone, though the main file
+// still calls into it.
+// SKIPPED: f2(s.c_str());
+// MAIN: f2(s); f3(s); }
+
+namespace std {
+template<typename T> class allocator {};
+template<typename T> class char_traits {};
+template<typename C, typename T, typename A> struct basic_string {
+  basic_string();
+  basic_string(const C *p, const A& a = A());
+  const C *c_str() const;
+};
+typedef basic_string<char, std::char_traits<char>, std::allocator<char> > string;
+}
+
+inline void f1(const std::string &s) {
+  f1(s.c_str());
+  // CHECK: inline void f1
+  // CHECK-NEXT: f1(s);
+}
@@ -2,9 +2,14 @@
 // RUN: cp "%s" "%T/test.cpp"
 // RUN: remove-cstr-calls "%T" "%T/test.cpp"
 // RUN: cat "%T/test.cpp" | FileCheck %s
+// RUN: remove-cstr-calls -stdin . input.cpp -- < "%s" | FileCheck %s
+// RUN: remove-cstr-calls -stdin -print-replacements . input.cpp -- < "%s" \
+// RUN:   | FileCheck -check-prefix=REPLACE %s
 // REQUIRES: shell
-// FIXME: implement a mode for refactoring tools that takes input from stdin
-// and writes output to stdout for easier testing of tools. 
+// REPLACE: {{[0-9]+}}:9:s
+// REPLACE-NEXT: {{[0-9]+}}:9:s
+// REPLACE-NEXT: {{[0-9]+}}:9:s
+// REPLACE-NOT: :
 
 namespace std {
 template<typename T> class allocator {};
@@ -0,0 +1,56 @@
+// RUN: rm -rf "%T/conflict" && mkdir -p "%T/conflict"
+// RUN: cp "%s" "%T/conflict/conflict.h"
+// RUN: printf '#include "conflict.h"\n#include "shared.cpp"\n' > "%T/conflict/a.cpp"
+// RUN: echo '#include "conflict.h"' > "%T/conflict/b.cpp"
+// RUN: printf '#include "conflict.h"\nvoid f3(const std::string &t) { f4(t.c_str()); }\n' > "%T/conflict/shared.cpp"
+// RUN: echo '[{"directory":"%T/conflict","command":"clang++ -c a.cpp -DTU_A","file":"%T/conflict/a.cpp"},{"directory":"%T/conflict","command":"clang++ -c b.cpp","file":"%T/conflict/b.cpp"},{"directory":"%T/conflict","command":"clang++ -c shared.cpp","file":"%T/conflict/shared.cpp"}]' > "%T/conflict/compile_commands.json"
+// RUN: remove-cstr-calls -j 2 "%T/conflict" "%T/conflict/a.cpp" "%T/conflict/b.cpp" "%T/conflict/shared.cpp" 2> "%T/conflict/stderr"
+// RUN: FileCheck -check-prefix=HEADER %s < "%T/conflict/stderr"
+// RUN: FileCheck -check-prefix=SOURCE %s < "%T/conflict/stderr"
+// RUN: cat "%T/conflict/conflict.h" | FileCheck %s
+// RUN: cat "%T/conflict/shared.cpp" | FileCheck -check-prefix=SHARED %s
+// REQUIRES: shell
+
+// a.cpp and b.cpp see f2 below differently: a.cpp removes the outer
+// c_str() call, b.cpp the inner one.  The edits overlap, and the one from
+// a.cpp, the earlier file, is kept however the files finish.
+// HEADER: Conflicting replacements in {{.*}}/conflict.h:
+// HEADER-NEXT: kept {{[0-9]+}}:{{[0-9]+}}:"std::string(t.c_str())" from {{.*}}/a.cpp
+// HEADER-NEXT: dropped {{[0-9]+}}:{{[0-9]+}}:"t" from {{.*}}/b.cpp
+
+// a.cpp also edits shared.cpp, which is parsed on its own without the
+// edit; the edit is reported and not made.
+// SOURCE: Replacement in {{.*}}/shared.cpp from {{.*}}/a.cpp was not made by the file itself: {{[0-9]+}}:{{[0-9]+}}:"t"
+// SHARED: f4(t.c_str());
+
+#ifndef CONFLICT_H
+#define CONFLICT_H
+
+namespace std {
+template<typename T> class allocator {};
+template<typename T> class char_traits {};
+template<typename C, typename T, typename A> struct basic_string {
+  basic_string();
+  basic_string(const C *p, const A& a = A());
+  const C *c_str() const;
+};
+typedef basic_string<char, std::char_traits<char>, std::allocator<char> > string;
+}
+
+#ifdef TU_A
+struct Arg { const char *c_str() const; };
+void f1(const std::string &s);
+void f4(const std::string &s);
+#else
+typedef std::string Arg;
+void f1(const char *p);
+void f4(const char *p);
+#endif
+
+inline void f2(const Arg &t) {
+  f1(std::string(t.c_str()).c_str());
+  // CHECK: inline void f2
+  // CHECK-NEXT: f1(std::string(t.c_str()));
+}
+
+#endif
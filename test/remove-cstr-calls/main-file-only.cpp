@@ -0,0 +1,30 @@
+// RUN: cp "%s" "%T/main-file-only.h"
+// RUN: echo '#include "main-file-only.h"' > "%T/main-file-only.cpp"
+// RUN: echo 'void f2(const std::string &s) { f2(s.c_str()); }' >> "%T/main-file-only.cpp"
+// RUN: echo '[{"directory":".","command":"clang++ -c %T/main-file-only.cpp","file":"%T/main-file-only.cpp"}]' > %T/compile_commands.json
+// RUN: remove-cstr-calls -main-file-only "%T" "%T/main-file-only.cpp"
+// RUN: cat "%T/main-file-only.cpp" | FileCheck -check-prefix=MAIN %s
+// RUN: cat "%T/main-file-only.h" | FileCheck %s
+// REQUIRES: shell
+
+// This file is the header: its declarations are skipped, so its call is
+// left alone, while the main file's call still resolves to the string
+// class declared here.
+// MAIN: f2(s);
+
+namespace std {
+template<typename T> class allocator {};
+template<typename T> class char_traits {};
+template<typename C, typename T, typename A> struct basic_string {
+  basic_string();
+  basic_string(const C *p, const A& a = A());
+  const C *c_str() const;
+};
+typedef basic_string<char, std::char_traits<char>, std::allocator<char> > string;
+}
+
+inline void f1(const std::string &s) {
+  f1(s.c_str());
+  // CHECK: inline void f1
+  // CHECK-NEXT: f1(s.c_str());
+}
@@ -0,0 +1,30 @@
+// RUN: rm -rf "%T/dirs" && mkdir -p "%T/dirs/a" "%T/dirs/b" "%T/dirs/inc"
+// RUN: cp "%s" "%T/dirs/inc/dirs.h"
+// RUN: echo '#include "dirs.h"' > "%T/dirs/a/a1.cpp"
+// RUN: echo '#include "dirs.h"' > "%T/dirs/a/a2.cpp"
+// RUN: echo '#include "dirs.h"' > "%T/dirs/b/b.cpp"
+// RUN: echo '[{"directory":"%T/dirs/a","command":"clang++ -c a1.cpp -I../inc","file":"%T/dirs/a/a1.cpp"},{"directory":"%T/dirs/b","command":"clang++ -c b.cpp -I../inc","file":"%T/dirs/b/b.cpp"},{"directory":"%T/dirs/a","command":"clang++ -c a2.cpp -I../inc","file":"%T/dirs/a/a2.cpp"}]' > "%T/dirs/compile_commands.json"
+// RUN: remove-cstr-calls -j 2 "%T/dirs" "%T/dirs/a/a1.cpp" "%T/dirs/b/b.cpp" "%T/dirs/a/a2.cpp"
+// RUN: cat "%T/dirs/inc/dirs.h" | FileCheck %s
+// REQUIRES: shell
+
+// The files are compiled in two directories, with include paths relative
+// to them.  Each directory's files run in parallel, one directory at a
+// time, and every file finds the header.
+
+namespace std {
+template<typename T> class allocator {};
+template<typename T> class char_traits {};
+template<typename C, typename T, typename A> struct basic_string {
+  basic_string();
+  basic_string(const C *p, const A& a = A());
+  const C *c_str() const;
+};
+typedef basic_string<char, std::char_traits<char>, std::allocator<char> > string;
+}
+
+inline void f1(const std::string &s) {
+  f1(s.c_str());
+  // CHECK: inline void f1
+  // CHECK-NEXT: f1(s);
+}
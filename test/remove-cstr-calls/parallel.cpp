@@ -0,0 +1,26 @@
+// RUN: cp "%s" "%T/parallel.h"
+// RUN: echo '#include "parallel.h"' > "%T/parallel-a.cpp"
+// RUN: echo '#include "parallel.h"' > "%T/parallel-b.cpp"
+// RUN: echo '[{"directory":".","command":"clang++ -c %T/parallel-a.cpp","file":"%T/parallel-a.cpp"},{"directory":".","command":"clang++ -c %T/parallel-b.cpp","file":"%T/parallel-b.cpp"}]' > %T/compile_commands.json
+// RUN: remove-cstr-calls -j 2 "%T" "%T/parallel-a.cpp" "%T/parallel-b.cpp"
+// RUN: cat "%T/parallel.h" | FileCheck %s
+// REQUIRES: shell
+
+// Both files find the same edit in the header; it must be made once.
+
+namespace std {
+template<typename T> class allocator {};
+template<typename T> class char_traits {};
+template<typename C, typename T, typename A> struct basic_string {
+  basic_string();
+  basic_string(const C *p, const A& a = A());
+  const C *c_str() const;
+};
+typedef basic_string<char, std::char_traits<char>, std::allocator<char> > string;
+}
+
+inline void f1(const std::string &s) {
+  f1(s.c_str());
+  // CHECK: inline void f1
+  // CHECK-NEXT: f1(s);
+}
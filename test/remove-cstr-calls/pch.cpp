@@ -0,0 +1,43 @@
+// RUN: rm -rf "%T/pch" && mkdir -p "%T/pch/src" "%T/pch/inc" "%T/pch/inc2" "%T/pch/out"
+// RUN: cp "%s" "%T/pch/inc2/other.h"
+// RUN: printf '#ifndef COMMON_H\n#define COMMON_H\n#include "other.h"\n#endif\n' > "%T/pch/inc/common.h"
+// RUN: printf '#ifndef LOCAL_H\n#define LOCAL_H\n#endif\n' > "%T/pch/src/local.h"
+// RUN: echo '#error the source directory is not on the include path' > "%T/pch/src/other.h"
+// RUN: printf '#include "local.h"\n#include "common.h"\nvoid a() {}\n' > "%T/pch/src/a.cpp"
+// RUN: printf '#include "local.h"\n#include "common.h"\nvoid b() {}\n' > "%T/pch/src/b.cpp"
+// RUN: echo '[{"directory":"%T/pch/src","command":"clang++ -c a.cpp -I../inc -I../inc2","file":"%T/pch/src/a.cpp"},{"directory":"%T/pch/src","command":"clang++ -c b.cpp -I../inc -I../inc2","file":"%T/pch/src/b.cpp"}]' > "%T/pch/compile_commands.json"
+// RUN: remove-cstr-calls -pch-dir "%T/pch/out" "%T/pch" "%T/pch/src/a.cpp" "%T/pch/src/b.cpp"
+// RUN: cat "%T/pch/inc2/other.h" | FileCheck %s
+// RUN: ls "%T/pch/out" | FileCheck -check-prefix=PCH %s
+// RUN: cat "%T/pch/out/prefix-0.h" | FileCheck -check-prefix=PREFIX %s
+// REQUIRES: shell
+
+// a.cpp and b.cpp share their #includes, so they share a PCH.  The prefix
+// header names local.h, which sits next to the sources, by absolute path;
+// common.h still finds other.h through -I, not src/other.h.
+
+// PCH: prefix-0.h.pch
+// PREFIX: #include "{{.*}}/pch/src/local.h"
+// PREFIX-NEXT: #include "common.h"
+
+#ifndef OTHER_H
+#define OTHER_H
+
+namespace std {
+template<typename T> class allocator {};
+template<typename T> class char_traits {};
+template<typename C, typename T, typename A> struct basic_string {
+  basic_string();
+  basic_string(const C *p, const A& a = A());
+  const C *c_str() const;
+};
+typedef basic_string<char, std::char_traits<char>, std::allocator<char> > string;
+}
+
+inline void f1(const std::string &s) {
+  f1(s.c_str());
+  // CHECK: inline void f1
+  // CHECK-NEXT: f1(s);
+}
+
+#endif
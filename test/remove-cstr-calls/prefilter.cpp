@@ -0,0 +1,26 @@
+// RUN: cp "%s" "%T/prefilter.cpp"
+// RUN: echo 'int f();' > "%T/prefilter-none.cpp"
+// RUN: echo '[{"directory":".","command":"clang++ -c %T/prefilter.cpp","file":"%T/prefilter.cpp"},{"directory":".","command":"clang++ -c %T/prefilter-none.cpp","file":"%T/prefilter-none.cpp"}]' > %T/compile_commands.json
+// RUN: remove-cstr-calls -prefilter "%T" "%T/prefilter.cpp" "%T/prefilter-none.cpp" \
+// RUN:   2>&1 >/dev/null | FileCheck -check-prefix=SKIP %s
+// RUN: cat "%T/prefilter.cpp" | FileCheck %s
+// REQUIRES: shell
+
+// SKIP: Skipped 1 of 2 files
+
+namespace std {
+template<typename T> class allocator {};
+template<typename T> class char_traits {};
+template<typename C, typename T, typename A> struct basic_string {
+  basic_string();
+  basic_string(const C *p, const A& a = A());
+  const C *c_str() const;
+};
+typedef basic_string<char, std::char_traits<char>, std::allocator<char> > string;
+}
+
+void f1(const std::string &s) {
+  f1(s.c_str());
+  // CHECK: void f1
+  // CHECK-NEXT: f1(s)
+}
@@ -0,0 +1,37 @@
+// RUN: echo '[{"directory":".","command":"clang++ -c %T/test.cpp","file":"%T/test.cpp"}]' > %T/compile_commands.json
+// RUN: cp "%s" "%T/test.cpp"
+// RUN: run-checks -checks=remove-cstr-calls,string-empty "%T" "%T/test.cpp" \
+// RUN:   | FileCheck -check-prefix=COUNT %s
+// RUN: cat "%T/test.cpp" | FileCheck %s
+// RUN: run-checks -list-checks | FileCheck -check-prefix=LIST %s
+// REQUIRES: shell
+
+// Both checks run from one parse, and each counts its own edits.
+// COUNT: remove-cstr-calls: 1 replacements
+// COUNT-NEXT: string-empty: 2 replacements
+// LIST: remove-cstr-calls -
+// LIST-NEXT: string-empty -
+
+namespace std {
+template<typename T> class allocator {};
+template<typename T> class char_traits {};
+template<typename C, typename T, typename A> struct basic_string {
+  basic_string();
+  basic_string(const C *p, const A& a = A());
+  const C *c_str() const;
+  unsigned long size() const;
+  bool empty() const;
+};
+typedef basic_string<char, std::char_traits<char>, std::allocator<char> > string;
+}
+
+void f1(const std::string &s) {
+  f1(s.c_str());
+  // CHECK: void f1
+  // CHECK-NEXT: f1(s)
+}
+bool f2(const std::string &s, const std::string *p) {
+  return s.size() == 0 || p->size() != 0;
+  // CHECK: bool f2
+  // CHECK-NEXT: return s.empty() || !p->empty();
+}
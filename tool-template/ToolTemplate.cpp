@@ -32,8 +32,17 @@
 //    /path/in/subtree $ find . -name '*.cpp'|
 //        xargs tool-template /path/to/build
 //
+//  To run your matchers in the same parse as the other checks, move the
+//  callback and its matchers into the checks library as a checks::Check
+//  (see checks/StringEmptyCheck.cpp) and list it in registry() in
+//  checks/Check.cpp; run-checks then runs it alongside the rest.
+//
+//  -pch-dir and -main-file-only work as they do for remove-cstr-calls.
+//
 //===----------------------------------------------------------------------===//
 
+#include "MainFileMatch.h"
+#include "PchCompilationDatabase.h"
 #include "clang/ASTMatchers/ASTMatchers.h"
 #include "clang/ASTMatchers/ASTMatchFinder.h"
 #include "clang/Basic/SourceManager.h"
@@ -78,10 +87,38 @@ cl::list<std::string> SourcePaths(
   cl::desc("<source0> [... <sourceN>]"),
   cl::OneOrMore);
 
+cl::opt<std::string> PchDir(
+  "pch-dir",
+  cl::desc("Precompile the #includes shared by files with the same "
+           "compile command into <dir>, and parse them once"),
+  cl::value_desc("dir"));
+
+cl::opt<bool> MainFileOnly(
+  "main-file-only",
+  cl::desc("Match only in top-level declarations of the main file and of "
+           "headers under -allow-dir"));
+
+cl::list<std::string> AllowDirs(
+  "allow-dir",
+  cl::desc("With -main-file-only, also match in headers under <dir>"),
+  cl::value_desc("dir"));
+
+// AllowDirs, made absolute before any compile command changes directory.
+static std::vector<std::string> AllowedDirs;
+
+static tooling::FrontendActionFactory *newActionFactory(
+    ast_matchers::MatchFinder *Finder) {
+  if (MainFileOnly)
+    return checks::newMainFileMatchActionFactory(Finder, AllowedDirs);
+  return newFrontendActionFactory(Finder);
+}
+
 int main(int argc, const char **argv) {
   llvm::OwningPtr<CompilationDatabase> Compilations(
         FixedCompilationDatabase::loadFromCommandLine(argc, argv));
   cl::ParseCommandLineOptions(argc, argv);
+  for (unsigned I = 0, E = AllowDirs.size(); I != E; ++I)
+    AllowedDirs.push_back(tooling::getAbsolutePath(AllowDirs[I]));
   if (!Compilations) {  // Couldn't find a compilation DB from the command line
     std::string ErrorMessage;
     Compilations.reset(
@@ -94,7 +131,13 @@ int main(int argc, const char **argv) {
     if (!Compilations)
       llvm::report_fatal_error(ErrorMessage);
     }
-  RefactoringTool Tool(*Compilations, SourcePaths);
+  llvm::OwningPtr<checks::PchCompilationDatabase> Pch;
+  if (!PchDir.empty()) {
+    Pch.reset(new checks::PchCompilationDatabase(*Compilations, PchDir));
+    Pch->build(SourcePaths);
+  }
+  const CompilationDatabase &Commands = Pch ? *Pch : *Compilations;
+  RefactoringTool Tool(Commands, SourcePaths);
   ast_matchers::MatchFinder Finder;
   ToolTemplateCallback Callback(&Tool.getReplacements());
 
@@ -102,5 +145,5 @@ int main(int argc, const char **argv) {
 // Use Finder.addMatcher(...) to define the patterns in the AST that you
 // want to match against. You are not limited to just one matcher!
 
-  return Tool.run(newFrontendActionFactory(&Finder));
+  return Tool.run(newActionFactory(&Finder));
 }